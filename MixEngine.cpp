@@ -10,6 +10,8 @@
 #include "Mx/Resource/MxResourceLoader.h"
 #include "Mx/Graphics/MxGraphics.h"
 #include "Mx/Scene/MxSceneManager.h"
+#include "Mx/Component/Transform/MxTransformSystem.h"
+#include "Mx/Thread/MxThreadPool.h"
 #include "Mx/Engine/MxPlatform.h"
 #include "MxApplicationBase.h"
 
@@ -48,6 +50,7 @@ namespace Mix {
         mApp->startUp(getCommandLines());
 
         try {
+            Rtti::Finalize();
             loadModule();
             initModule();
 
@@ -157,6 +160,7 @@ namespace Mix {
         SDL_Rect rect;
         SDL_GetDisplayBounds(0, &rect);
 
+        mModuleHolder.add<ThreadPool>()->load();
         mModuleHolder.add<Window>("Mix Engine Demo", Vector2i{ rect.w * 0.4f, rect.h * 0.8f }, WindowFlag::Vulkan | WindowFlag::Shown)->load();
         mModuleHolder.add<Input>()->load();
         mModuleHolder.add<Audio::Core>()->load();
@@ -165,6 +169,7 @@ namespace Mix {
         mModuleHolder.add<Graphics>()->load();
         mModuleHolder.add<GUI>()->load();
         mModuleHolder.add<ResourceLoader>()->load();
+        mModuleHolder.add<TransformSystem>()->load();
         mModuleHolder.add<SceneObjectManager>()->load();
         mModuleHolder.add<SceneManager>()->load();
 
@@ -201,6 +206,8 @@ namespace Mix {
         mApp->onGUI();
         mModuleHolder.get<GUI>()->endGUI();
         mModuleHolder.get<GUI>()->update();
+        mModuleHolder.get<TransformSystem>()->update();
+        mModuleHolder.get<SceneManager>()->updateSceneBounds();
         mModuleHolder.get<Graphics>()->update();
         mModuleHolder.get<Graphics>()->render();
 }
@@ -209,6 +216,7 @@ namespace Mix {
         mApp->onPostRender();
         mModuleHolder.get<SceneManager>()->scenePostRender();
         mModuleHolder.get<SceneObjectManager>()->postRender();
+        mModuleHolder.get<SceneManager>()->updateAsyncLoads();
         mModuleHolder.get<Input>()->nextFrame();
     }
 
@@ -1,17 +1,31 @@
 ﻿#include "MxBehaviour.h"
+#include "../../Scene/MxScene.h"
 
 namespace Mix {
     MX_IMPLEMENT_RTTI(Behaviour, Component);
 
+    Behaviour::~Behaviour() {
+        if (mScene)
+            mScene->unregisterBehaviour(this);
+    }
+
     void Behaviour::awakeInternal() {
         awake();
         onEnableInternal();
     }
 
+    void Behaviour::startInternal() {
+        start();
+        mStarted = true;
+
+        // Unstarted Behaviours are kept in the serial lists so that start() runs on the main thread
+        if (mScene)
+            mScene->onBehaviourStarted(this);
+    }
+
     void Behaviour::updateInternal() {
         if (!mStarted) {
-            start();
-            mStarted = true;
+            startInternal();
         }
         else {
             update();
@@ -20,8 +34,7 @@ namespace Mix {
 
     void Behaviour::fixedUpdateInternal() {
         if (!mStarted) {
-            start();
-            mStarted = true;
+            startInternal();
         }
         else {
             fixedUpdate();
@@ -30,22 +43,38 @@ namespace Mix {
 
     void Behaviour::lateUpdateInternal() {
         if (!mStarted) {
-            start();
-            mStarted = true;
+            startInternal();
         }
         else {
             lateUpdate();
         }
     }
 
+    void Behaviour::setAccess(BehaviourAccess _access, std::vector<const Rtti*> _types) {
+        // Move the Behaviour to the matching phase lists
+        const bool listed = mScene && mEnabled && mGameObject->activeInHierarchy();
+        if (listed)
+            mScene->removeFromPhaseLists(this);
+
+        mAccess = _access;
+        mAccessTypes = std::move(_types);
+
+        if (listed)
+            mScene->addToPhaseLists(this);
+    }
+
     void Behaviour::onEnableInternal() {
         mEnabled = true;
         onEnable();
+        if (mScene && mGameObject->activeInHierarchy())
+            mScene->addToPhaseLists(this);
     }
 
     void Behaviour::onDisableInternal() {
         mEnabled=false;
         onDisable();
+        if (mScene)
+            mScene->removeFromPhaseLists(this);
     }
 
 
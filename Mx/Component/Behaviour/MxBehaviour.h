@@ -4,26 +4,44 @@
 #define MX_BEHAVIOUR_H_
 
 #include "../MxComponent.h"
+#include <vector>
 
 namespace Mix {
+    class Scene;
+
+    /**
+     * \brief What a Behaviour touches during update() and fixedUpdate(). Decides whether the hooks
+     *        may be dispatched to worker threads.
+     */
+    enum class BehaviourAccess : uint8_t {
+        /** \brief Anything. The hooks run serially on the main thread, this is the default. */
+        MainThread,
+        /** \brief Only its own GameObject and the Components attached to it. */
+        OwnGameObject,
+        /** \brief Only Components of the declared types, on any GameObject. */
+        DeclaredComponents
+    };
+
     class Behaviour : public Component {
         MX_DECLARE_RTTI;
         friend class GameObject;
         friend class Scene;
     public:
         Behaviour() = default;
-        virtual ~Behaviour() = 0 {}
+        virtual ~Behaviour() = 0;
 
     protected:
         virtual void awake() {}
 
         virtual void start() {}
 
-        virtual void update() {}
+        // The default hooks drop the Behaviour from their phase list, so only overridden hooks cost anything per frame.
 
-        virtual void fixedUpdate() {}
+        virtual void update() { mPhaseMask &= ~(1u << Phase_Update); }
 
-        virtual void lateUpdate() {}
+        virtual void fixedUpdate() { mPhaseMask &= ~(1u << Phase_FixedUpdate); }
+
+        virtual void lateUpdate() { mPhaseMask &= ~(1u << Phase_LateUpdate); }
 
         virtual void onEnable() {}
 
@@ -31,9 +49,40 @@ namespace Mix {
 
         bool isEnabled() const { return mEnabled; }
 
+        /**
+         * \brief Declare that update() and fixedUpdate() only touch the own GameObject, so that they may run
+         *        on a worker thread in parallel with the Behaviours of other GameObjects.
+         * \note  Should be called in the constructor or in awake(). start() and the frame it runs in stay on the
+         *        main thread, so start() may do anything. Once the hooks run in parallel they must not create,
+         *        destroy, enable or disable anything and must not read world space transforms, which asserts.
+         *        Transform::cachedLocalToWorldMatrix() returns the matrix of the last frame and may be read.
+         */
+        void declareOwnGameObjectAccess() { setAccess(BehaviourAccess::OwnGameObject, {}); }
+
+        /**
+         * \brief Declare that update() and fixedUpdate() only touch Components of type _Ts (and types derived
+         *        from them) on any GameObject. Behaviours whose declared types overlap run serially with
+         *        respect to each other, all others run in parallel. The same restrictions as for
+         *        declareOwnGameObjectAccess() apply.
+         */
+        template<typename... _Ts>
+        void declareComponentAccess() {
+            static_assert(((std::is_base_of_v<Component, _Ts> && !std::is_same_v<Component, _Ts>) && ...),
+                          "Declared types must be derived from Component");
+            setAccess(BehaviourAccess::DeclaredComponents, { &_Ts::GetType()... });
+        }
+
+        /** \brief Run update() and fixedUpdate() serially on the main thread again. */
+        void declareMainThreadAccess() { setAccess(BehaviourAccess::MainThread, {}); }
+
+        BehaviourAccess getAccess() const { return mAccess; }
+
     private:
         void awakeInternal();
 
+        /** \brief Call start(), then let the Scene move this Behaviour to the parallel phase lists it declared. */
+        void startInternal();
+
         void updateInternal();
 
         void fixedUpdateInternal();
@@ -44,9 +93,46 @@ namespace Mix {
 
         void onDisableInternal();
 
+        void setAccess(BehaviourAccess _access, std::vector<const Rtti*> _types);
+
+        /** \brief Check whether the hook of _phase is still considered overridden. */
+        bool hasPhase(uint32_t _phase) const { return (mPhaseMask & (1u << _phase)) != 0; }
+
+        enum Phase : uint32_t {
+            Phase_Update,
+            Phase_FixedUpdate,
+            Phase_LateUpdate,
+            Phase_Count
+        };
+
+        /**
+         * \brief Check whether the hook of _phase runs on worker threads. lateUpdate() is always serial, and so
+         *        is every hook until start() has run, since start() is called in place of the first hook.
+         */
+        bool isParallel(uint32_t _phase) const {
+            return mStarted && mAccess != BehaviourAccess::MainThread && _phase != Phase_LateUpdate;
+        }
+
+        static constexpr uint32_t InvalidListIndex = ~0u;
+
         bool mStarted = false;
 
         bool mEnabled = false;
+
+        /** \brief Bit per Phase, cleared once the default hook of that phase has been called. */
+        uint8_t mPhaseMask = (1u << Phase_Count) - 1;
+
+        BehaviourAccess mAccess = BehaviourAccess::MainThread;
+
+        /** \brief Component types declared by declareComponentAccess(). */
+        std::vector<const Rtti*> mAccessTypes;
+
+        /** \brief The Scene this Behaviour is registered to, nullptr if none. */
+        Scene* mScene = nullptr;
+
+        /** \brief Position in the registered list and in each phase list (serial or parallel) of mScene. */
+        uint32_t mRegisteredIndex = InvalidListIndex;
+        uint32_t mPhaseIndices[Phase_Count] = { InvalidListIndex, InvalidListIndex, InvalidListIndex };
     };
 }
 
@@ -1,5 +1,12 @@
 #include "MxMeshFilter.h"
+#include "../Renderer/MxRenderer.h"
+#include "../../GameObject/MxGameObject.h"
 
 namespace Mix {
 	MX_IMPLEMENT_RTTI(MeshFilter, Component);
+
+	void MeshFilter::setMesh(std::shared_ptr<Mesh> _mesh) {
+		mMesh = std::move(_mesh);
+		getGameObject()->forEachComponent<Renderer>([](Renderer& _renderer) { _renderer._markRenderElementsDirty(); });
+	}
 }
\ No newline at end of file
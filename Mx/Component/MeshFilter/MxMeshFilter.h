@@ -12,9 +12,8 @@ namespace Mix {
 			return mMesh;
 		}
 
-		void setMesh(std::shared_ptr<Mesh> _mesh) {
-			mMesh = std::move(_mesh);
-		}
+		/** \brief Set the Mesh drawn by the Renderers of the GameObject. */
+		void setMesh(std::shared_ptr<Mesh> _mesh);
 	private:
 		std::shared_ptr<Mesh> mMesh;
 
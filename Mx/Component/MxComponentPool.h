@@ -0,0 +1,233 @@
+#pragma once
+
+#ifndef MX_COMPONENT_POOL_H_
+#define MX_COMPONENT_POOL_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Mix {
+    /**
+     * \brief Hands out fixed-size blocks carved from large chunks, freed blocks are kept in a free list.
+     *
+     * \note  NOT thread-safe. Pools are never destroyed so that objects released during shutdown
+     *        can still return their memory.
+     */
+    template<size_t _Size, size_t _Align>
+    class FixedBlockPool {
+    public:
+        static FixedBlockPool& Get() {
+            static auto* pool = new FixedBlockPool();
+            return *pool;
+        }
+
+        void* allocate() {
+            if (mFreeList == nullptr)
+                grow();
+            FreeBlock* block = mFreeList;
+            mFreeList = block->next;
+            return block;
+        }
+
+        void deallocate(void* _ptr) {
+            auto block = static_cast<FreeBlock*>(_ptr);
+            block->next = mFreeList;
+            mFreeList = block;
+        }
+
+    private:
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        static constexpr size_t BlockAlign = _Align > alignof(FreeBlock) ? _Align : alignof(FreeBlock);
+        static constexpr size_t BlockSize = (std::max(_Size, sizeof(FreeBlock)) + BlockAlign - 1) / BlockAlign * BlockAlign;
+        static constexpr size_t BlocksPerChunk = 64;
+
+        using Chunk = std::aligned_storage_t<BlockSize * BlocksPerChunk, BlockAlign>;
+
+        FixedBlockPool() = default;
+
+        void grow() {
+            mChunks.push_back(std::make_unique<Chunk>());
+            auto bytes = reinterpret_cast<char*>(mChunks.back().get());
+            for (size_t i = BlocksPerChunk; i-- > 0;)
+                deallocate(bytes + i * BlockSize);
+        }
+
+        FreeBlock* mFreeList = nullptr;
+        std::vector<std::unique_ptr<Chunk>> mChunks;
+    };
+
+
+    /**
+     * \brief Allocator routing the control blocks of pooled shared_ptrs into a FixedBlockPool.
+     */
+    template<typename _Ty>
+    class PoolAllocator {
+    public:
+        using value_type = _Ty;
+
+        PoolAllocator() = default;
+
+        template<typename _U>
+        PoolAllocator(const PoolAllocator<_U>&) noexcept {}
+
+        _Ty* allocate(size_t _n) {
+            if (_n != 1)
+                return static_cast<_Ty*>(::operator new(_n * sizeof(_Ty)));
+            return static_cast<_Ty*>(FixedBlockPool<sizeof(_Ty), alignof(_Ty)>::Get().allocate());
+        }
+
+        void deallocate(_Ty* _ptr, size_t _n) noexcept {
+            if (_n != 1)
+                ::operator delete(_ptr);
+            else
+                FixedBlockPool<sizeof(_Ty), alignof(_Ty)>::Get().deallocate(_ptr);
+        }
+
+        template<typename _U>
+        bool operator==(const PoolAllocator<_U>&) const noexcept { return true; }
+
+        template<typename _U>
+        bool operator!=(const PoolAllocator<_U>&) const noexcept { return false; }
+    };
+
+
+    /**
+     * \brief Contiguous storage for every Component of exact type _Ty.
+     *
+     *        Components are stored in chunks of 64, so iterating all components of a type walks
+     *        contiguous memory. Neither the components nor their shared_ptr control blocks go
+     *        through the general-purpose allocator once the pool has warmed up.
+     *
+     * \note  NOT thread-safe. Components of types derived from _Ty live in their own pools.
+     */
+    template<typename _Ty>
+    class ComponentPool {
+    public:
+        static ComponentPool& Get() {
+            // Never destroyed, components may be released after static destruction has begun
+            static auto* pool = new ComponentPool();
+            return *pool;
+        }
+
+        /**
+         * \brief Construct a _Ty in the pool.
+         * \param _construct Callable placement-constructing a _Ty in the given memory and returning it.
+         */
+        template<typename _Construct>
+        std::shared_ptr<_Ty> create(_Construct&& _construct) {
+            uint32_t index = allocate();
+            _Ty* ptr;
+            try {
+                ptr = _construct(slotMemory(index));
+            }
+            catch (...) {
+                release(index);
+                throw;
+            }
+            setAlive(index, true);
+            return std::shared_ptr<_Ty>(ptr, Deleter{ index }, PoolAllocator<_Ty>());
+        }
+
+        /** \brief Get the amount of alive components. */
+        uint32_t size() const { return mAliveCount; }
+
+        /** \brief Make sure the next _count components can be created without allocating. */
+        void reserve(uint32_t _count) {
+            while (mFreeSlots.size() < _count)
+                grow();
+        }
+
+        /**
+         * \brief Call _func(_Ty&) for every alive component, in storage order.
+         * \note  Components must not be created or destroyed by _func.
+         */
+        template<typename _Func>
+        void forEach(_Func&& _func) {
+            for (auto& chunk : mChunks) {
+                uint64_t mask = chunk->alive;
+                while (mask != 0) {
+                    const uint32_t bit = LowestBit(mask);
+                    mask &= mask - 1;
+                    _func(*reinterpret_cast<_Ty*>(&chunk->slots[bit]));
+                }
+            }
+        }
+
+    private:
+        static constexpr uint32_t SlotsPerChunk = 64;
+
+        struct Chunk {
+            std::aligned_storage_t<sizeof(_Ty), alignof(_Ty)> slots[SlotsPerChunk];
+            uint64_t alive = 0;
+        };
+
+        struct Deleter {
+            uint32_t index;
+
+            void operator()(_Ty* _ptr) const {
+                ComponentPool& pool = Get();
+                pool.setAlive(index, false);
+                _ptr->~_Ty();
+                pool.release(index);
+            }
+        };
+
+        ComponentPool() = default;
+
+        static uint32_t LowestBit(uint64_t _mask) {
+            uint32_t bit = 0;
+            while ((_mask & 1) == 0) {
+                _mask >>= 1;
+                ++bit;
+            }
+            return bit;
+        }
+
+        void grow() {
+            const uint32_t base = static_cast<uint32_t>(mChunks.size()) * SlotsPerChunk;
+            mChunks.push_back(std::make_unique<Chunk>());
+            for (uint32_t i = SlotsPerChunk; i-- > 0;)
+                mFreeSlots.push_back(base + i);
+        }
+
+        uint32_t allocate() {
+            if (mFreeSlots.empty())
+                grow();
+            const uint32_t index = mFreeSlots.back();
+            mFreeSlots.pop_back();
+            return index;
+        }
+
+        void release(uint32_t _index) { mFreeSlots.push_back(_index); }
+
+        void* slotMemory(uint32_t _index) {
+            return &mChunks[_index / SlotsPerChunk]->slots[_index % SlotsPerChunk];
+        }
+
+        void setAlive(uint32_t _index, bool _alive) {
+            uint64_t& mask = mChunks[_index / SlotsPerChunk]->alive;
+            const uint64_t bit = uint64_t(1) << (_index % SlotsPerChunk);
+            if (_alive) {
+                mask |= bit;
+                ++mAliveCount;
+            }
+            else {
+                mask &= ~bit;
+                --mAliveCount;
+            }
+        }
+
+        std::vector<std::unique_ptr<Chunk>> mChunks;
+        std::vector<uint32_t> mFreeSlots;
+        uint32_t mAliveCount = 0;
+    };
+}
+
+#endif
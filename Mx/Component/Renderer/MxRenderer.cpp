@@ -1,8 +1,29 @@
 #include "MxRenderer.h"
+#include "../../Scene/MxScene.h"
 
 namespace Mix {
     MX_IMPLEMENT_RTTI(Renderer, Component);
 
+    Renderer::~Renderer() {
+        if (mScene)
+            mScene->unregisterRenderer(this);
+    }
+
+    void Renderer::setEnable(const bool _enable) {
+        mEnable = _enable;
+        if (mScene)
+            mScene->updateRenderer(this);
+    }
+
+    void Renderer::_markRenderElementsDirty() {
+        if (mRenderElementsDirty)
+            return;
+
+        mRenderElementsDirty = true;
+        if (mScene)
+            mScene->mDirtyRenderers.push_back(this);
+    }
+
     std::shared_ptr<Material> Renderer::getMaterial() const {
         if (mMaterials.empty())
             return nullptr;
@@ -18,13 +39,16 @@ namespace Mix {
             mMaterials.push_back(std::move(_material));
         else
             mMaterials[0] = std::move(_material);
+        _markRenderElementsDirty();
     }
 
     void Renderer::setMaterials(const std::vector<std::shared_ptr<Material>>& _materials) {
         mMaterials = _materials;
+        _markRenderElementsDirty();
     }
 
     void Renderer::setMaterials(std::vector<std::shared_ptr<Material>>&& _materials) {
         mMaterials = std::move(_materials);
+        _markRenderElementsDirty();
     }
 }
@@ -3,9 +3,12 @@
 #define MX_MESH_RENDERER_H_
 
 #include "../MxComponent.h"
+#include "../../Graphics/MxRenderInfo.h"
 
 namespace Mix {
     class Material;
+    class Scene;
+    class Graphics;
 
     namespace Vulkan {
         class VulkanAPI;
@@ -14,7 +17,12 @@ namespace Mix {
     class Renderer :public Component {
         MX_DECLARE_RTTI;
         friend class Vulkan::VulkanAPI;
+        friend class Graphics;
+        friend class Scene;
+        friend class StaticBatch;
     public:
+        ~Renderer();
+
         std::shared_ptr<Material> getMaterial() const;
 
         const std::vector<std::shared_ptr<Material>>& getMaterials() const;
@@ -27,12 +35,47 @@ namespace Mix {
 
         bool isEnable() const { return mEnable; }
 
-        void setEnable(const bool _enable) { mEnable = _enable; }
+        void setEnable(const bool _enable);
+
+        /** \brief Check if this Renderer is drawn as part of a StaticBatch of its Scene. */
+        bool isStaticBatched() const { return mStaticBatched; }
+
+        /**
+         * \brief One element per submesh drawn, kept up to date by the Scene before rendering.
+         * \note  Empty until the Renderer was registered to a Scene and the next frame started.
+         */
+        const std::vector<RenderElement>& getRenderElements() const { return mRenderElements; }
+
+        /** \brief Have the Scene rebuild the render elements, called when the Mesh or the Materials change. */
+        void _markRenderElementsDirty();
 
     private:
+        static constexpr uint32_t InvalidRenderIndex = ~0u;
+        static constexpr uint32_t InvalidBoundsProxy = ~0u;
+
         std::vector<std::shared_ptr<Material>> mMaterials;
         bool mEnable = true;
 
+        /** \brief The Scene this Renderer is registered to, nullptr if none. */
+        Scene* mScene = nullptr;
+
+        /** \brief Position in the renderer list of mScene. */
+        uint32_t mRenderIndex = InvalidRenderIndex;
+
+        bool mStaticBatched = false;
+
+        /** \brief Proxy of this Renderer in the bounds tree of mScene, inserted once it has a Mesh. */
+        uint32_t mBoundsProxy = InvalidBoundsProxy;
+
+        /** \brief Transform node of the GameObject while registered, and the next Renderer of mScene on that node. */
+        uint32_t mBoundsNode = ~0u;
+        Renderer* mNextOnNode = nullptr;
+
+        std::vector<RenderElement> mRenderElements;
+
+        /** \brief Set while this Renderer waits in the dirty list of mScene. */
+        bool mRenderElementsDirty = false;
+
     };
 }
 
@@ -14,6 +14,7 @@ namespace Mix {
     class Vector3;
     class Quaternion;
     class Transform;
+    class Prefab;
 
     namespace Physics {
         class World;
@@ -25,6 +26,7 @@ namespace Mix {
     MX_DECLARE_RTTI;
 
         friend Physics::World;
+        friend Prefab;
 
     public:
         using Signal = boost::signals2::signal<void(HRigidBody)>;
@@ -8,29 +8,31 @@ using namespace Mix::Math;
 namespace Mix {
 	MX_IMPLEMENT_RTTI(Transform, Component);
 
+	Transform::Transform() :mSystem(TransformSystem::Get()), mNode(mSystem->createNode()) {
+	}
+
+	Transform::~Transform() {
+		mSystem->destroyNode(mNode);
+	}
+
 	Vector3f Transform::forward() const {
-		updateLocalToWorldMatrix();
-		return mLocalToWorld.multiplyDirection(Vector3f::Forward);
+		return localToWorldMatrix().multiplyDirection(Vector3f::Forward);
 	}
 
 	Vector3f Transform::right() const {
-		updateLocalToWorldMatrix();
-		return mLocalToWorld.multiplyDirection(Vector3f::Right);
+		return localToWorldMatrix().multiplyDirection(Vector3f::Right);
 	}
 
 	Vector3f Transform::up() const {
-		updateLocalToWorldMatrix();
-		return mLocalToWorld.multiplyDirection(Vector3f::Up);
+		return localToWorldMatrix().multiplyDirection(Vector3f::Up);
 	}
 
 	const Matrix4& Transform::localToWorldMatrix() const {
-		updateLocalToWorldMatrix();
-		return mLocalToWorld;
+		return mSystem->getLocalToWorld(mNode);
 	}
 
 	Matrix4 Transform::worldToLocalMatrix() const {
-		updateLocalToWorldMatrix();
-		return mLocalToWorld.inverse();
+		return localToWorldMatrix().inverse();
 	}
 
 	Transform* Transform::root() const {
@@ -43,7 +45,7 @@ namespace Mix {
 		Vector3f tr;
 		switch (_relativeTo) {
 		case Space::Self:
-			tr = mQuat * _translation;
+			tr = getLocalRotation() * _translation;
 			if (mGameObject && mGameObject->getParent())
 				tr /= mGameObject->getParent()->transform().getLocalScale();
 			break;
@@ -55,8 +57,7 @@ namespace Mix {
 			}
 			break;
 		}
-		mPosition += tr;
-		recurSetHasChanged();
+		setLocalPosition(getLocalPosition() + tr);
 	}
 
 	void Transform::translate(const Vector3f& _translation, const Transform& _relativeTo) {
@@ -65,19 +66,19 @@ namespace Mix {
 	}
 
 	void Transform::rotate(const Quaternion& _qua, const Space _relativeTo) {
+		const Quaternion& quat = getLocalRotation();
 		switch (_relativeTo) {
 		case Space::Self:
-			mQuat = mQuat * _qua;
+			setLocalRotation(quat * _qua);
 			break;
 		case Space::World:
 			if (mGameObject && mGameObject->getParent()) {
 				auto p = mGameObject->getParent()->transform().getRotation();
-				mQuat = p.inverse() * _qua * p * mQuat;
+				setLocalRotation(p.inverse() * _qua * p * quat);
 			} else
-				mQuat = _qua * mQuat;
+				setLocalRotation(_qua * quat);
 			break;
 		}
-		recurSetHasChanged();
 	}
 
 	void Transform::rotateAround(const Vector3f& _point, const Vector3f& _axis, const float _angle) {
@@ -118,62 +119,45 @@ namespace Mix {
 	}
 
     void Transform::forceUpdate() {
-        updateLocalToWorldMatrix();
+        mSystem->getLocalToWorld(mNode);
     }
 
-    void Transform::updateLocalToWorldMatrix() const {
-		if (mChanged) {
-			mLocalToWorld = Matrix4::TRS(mPosition, mQuat, mScale);
-			if (mGameObject && mGameObject->getParent())
-				mLocalToWorld = mGameObject->getParent()->transform().localToWorldMatrix()*mLocalToWorld;
-			mChanged = false;
-		}
-	}
-
-	void Transform::recurSetHasChanged() const {
-		mChanged = true;
-		if (mGameObject) {
-			auto children = mGameObject->getAllChildren();
-			for (auto child : children) {
-				child->transform().recurSetHasChanged();
-			}
-		}
+	void Transform::setParentInternal(const Transform* _parent) {
+		mSystem->setParent(mNode, _parent ? _parent->mNode : TransformSystem::InvalidNode);
 	}
 
 	Vector3f Transform::getPosition() const {
 		if (!mGameObject || !mGameObject->getParent())
-			return mPosition;
-		return mGameObject->getParent()->transform().localToWorldMatrix().multiplyPoint(mPosition);
+			return getLocalPosition();
+		return mGameObject->getParent()->transform().localToWorldMatrix().multiplyPoint(getLocalPosition());
 	}
 
 	void Transform::setPosition(const Vector3f& _pos) {
 		if (mGameObject && mGameObject->getParent()) {
-			mPosition = mGameObject->getParent()->transform().worldToLocalMatrix().multiplyPoint(_pos);
+			setLocalPosition(mGameObject->getParent()->transform().worldToLocalMatrix().multiplyPoint(_pos));
 		} else
-			mPosition = _pos;
-		recurSetHasChanged();
+			setLocalPosition(_pos);
 	}
 
 	Quaternion Transform::getRotation() const {
 		// get rotation from LocalToWorldMatrix maybe slow
 		// avoid using this if has no parent
 		if (!mGameObject || !mGameObject->getParent())
-			return mQuat;
+			return getLocalRotation();
 
-		return mGameObject->getParent()->transform().getRotation() * mQuat;
+		return mGameObject->getParent()->transform().getRotation() * getLocalRotation();
 	}
 
 	void Transform::setRotation(const Quaternion& _qua) {
 		if (mGameObject && mGameObject->getParent()) {
-			mQuat = mGameObject->getParent()->transform().worldToLocalMatrix().getRotation() * _qua;
+			setLocalRotation(mGameObject->getParent()->transform().worldToLocalMatrix().getRotation() * _qua);
 		} else
-			mQuat = _qua;
-		recurSetHasChanged();
+			setLocalRotation(_qua);
 	}
 
 	Vector3f Transform::getLossyScale() const {
 		if (!mGameObject || !mGameObject->getParent())
-			return mScale;
+			return getLocalScale();
 
 		Matrix4 m = Matrix4::TRS(getPosition(), getRotation(), Vector3f::One).inverse()*localToWorldMatrix();
 		return Vector3f(m[0][0], m[1][1], m[2][2]);
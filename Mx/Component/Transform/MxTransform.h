@@ -8,11 +8,20 @@
 
 #include "../../Math/MxMatrix4.h"
 #include "../../Math/MxQuaternion.h"
+#include "MxTransformSystem.h"
 
 namespace Mix {
+    /**
+     * \brief Transform is a view of a node in the TransformSystem, which owns the actual data.
+     */
     class Transform :public Component {
         MX_DECLARE_RTTI;
+        friend GameObject;
     public:
+        Transform();
+
+        ~Transform();
+
         Vector3f getPosition() const; // done
 
         void setPosition(const Vector3f& _pos); // done
@@ -23,28 +32,25 @@ namespace Mix {
 
         Vector3f getLossyScale() const; // done
 
-        const Vector3f& getLocalPosition() const { return mPosition; } // done
+        const Vector3f& getLocalPosition() const { return mSystem->getLocalPosition(mNode); } // done
 
         void setLocalPosition(const Vector3f& _pos) {
-            mPosition = _pos;
-            recurSetHasChanged();
+            mSystem->setLocalPosition(mNode, _pos);
         } // done
 
-        const Quaternion& getLocalRotation() const { return mQuat; } // done
+        const Quaternion& getLocalRotation() const { return mSystem->getLocalRotation(mNode); } // done
 
         void setLocalRotation(const Quaternion& _qua) {
-            mQuat = _qua;
-            recurSetHasChanged();
+            mSystem->setLocalRotation(mNode, _qua);
         } // done
 
-        const Vector3f& getLocalScale() const { return mScale; } // done
+        const Vector3f& getLocalScale() const { return mSystem->getLocalScale(mNode); } // done
 
         void setLocalScale(const Vector3f& _scale) {
-            mScale = _scale;
-            recurSetHasChanged();
+            mSystem->setLocalScale(mNode, _scale);
         } // done
 
-        bool hasChanged() const { return mChanged; } // done
+        bool hasChanged() const { return mSystem->isDirty(mNode); } // done
 
         Vector3f forward() const; // done
 
@@ -56,6 +62,12 @@ namespace Mix {
 
         Matrix4 worldToLocalMatrix() const; // done
 
+        /**
+         * \brief Get the local to world matrix computed by the last TransformSystem::update().
+         *        Never recomputes anything, use this when reading transforms during rendering.
+         */
+        const Matrix4& cachedLocalToWorldMatrix() const { return mSystem->getCachedLocalToWorld(mNode); }
+
         Transform* root() const;
 
         void translate(const Vector3f& _translation, const Space _relativeTo = Space::Self); // done
@@ -94,17 +106,14 @@ namespace Mix {
 
         void forceUpdate();
 
-    private:
-        Vector3f mPosition;
-        Quaternion mQuat;
-        Vector3f mScale = Vector3f::One;
-
-        mutable Matrix4 mLocalToWorld;
-        mutable bool mChanged = true;
+        TransformSystem::NodeId _getNode() const { return mNode; }
 
-        void updateLocalToWorldMatrix() const;
+    private:
+        TransformSystem* mSystem;
+        TransformSystem::NodeId mNode;
 
-        void recurSetHasChanged() const;
+        /** \brief Keep the node hierarchy in sync with the GameObject hierarchy, nullptr makes it a root. */
+        void setParentInternal(const Transform* _parent);
     };
 }
 
@@ -0,0 +1,417 @@
+#include "MxTransformSystem.h"
+#include "../../../MixEngine.h"
+#include "../../Thread/MxThreadPool.h"
+#include "../../Definitions/MxDefinitions.h"
+#include <algorithm>
+
+namespace Mix {
+    TransformSystem* TransformSystem::Get() {
+        return MixEngine::Instance().getModule<TransformSystem>();
+    }
+
+    void TransformSystem::update() {
+        if (mOrderDirty)
+            rebuildOrder();
+        mPatchedSwaps = 0;
+
+        mChainScratch.resize(nodeCount());
+
+        // Parents are finalized one level before their children, the nodes of a level are independent
+        auto threadPool = ThreadPool::Get();
+        for (uint32_t level = 0; level + 1 < mLevelOffsets.size(); ++level) {
+            threadPool->parallelFor(mLevelOffsets[level], mLevelOffsets[level + 1], UpdateGrainSize,
+                                    [this](uint32_t _begin, uint32_t _end) {
+                                        for (uint32_t i = _begin; i < _end; ++i)
+                                            updateNode(i);
+                                    });
+        }
+
+        // A byte scan in dense order, cheaper than having every consumer test its own nodes
+        mUpdatedNodes.clear();
+        for (uint32_t i = 0; i < nodeCount(); ++i) {
+            if (mUpdated[i])
+                mUpdatedNodes.push_back(mNodeIds[i]);
+        }
+
+        mLastUpdateVersion = mVersion;
+    }
+
+    void TransformSystem::updateNode(uint32_t _index) {
+        // Propagate the latest change on the ancestor chain down to this node
+        const uint32_t parent = mParentIndices[_index];
+        Version chain = mChangedVersions[_index];
+        if (parent != InvalidIndex)
+            chain = std::max(chain, mChainScratch[parent]);
+        mChainScratch[_index] = chain;
+
+        mUpdated[_index] = chain > mLastUpdateVersion;
+
+        if (chain <= mComputedVersions[_index])
+            return;
+
+        mLocalToWorld[_index] = Matrix4::TRS(mPositions[_index], mRotations[_index], mScales[_index]);
+        if (parent != InvalidIndex)
+            mLocalToWorld[_index] = mLocalToWorld[parent] * mLocalToWorld[_index];
+        mComputedVersions[_index] = mVersion;
+    }
+
+    TransformSystem::NodeId TransformSystem::createNode() {
+        NodeId id;
+        if (!mFreeIds.empty()) {
+            id = mFreeIds.back();
+            mFreeIds.pop_back();
+        }
+        else {
+            id = static_cast<NodeId>(mSparse.size());
+            mSparse.push_back(InvalidIndex);
+            mDepths.push_back(0);
+            mFirstChildren.push_back(InvalidNode);
+            mNextSiblings.push_back(InvalidNode);
+            mPrevSiblings.push_back(InvalidNode);
+        }
+
+        mSparse[id] = nodeCount();
+        mDepths[id] = 0;
+        mFirstChildren[id] = InvalidNode;
+        mNextSiblings[id] = InvalidNode;
+        mPrevSiblings[id] = InvalidNode;
+        mNodeIds.push_back(id);
+        mParentIds.push_back(InvalidNode);
+        mParentIndices.push_back(InvalidIndex);
+        mPositions.emplace_back(Vector3f::Zero);
+        mRotations.emplace_back(Quaternion::Identity);
+        mScales.emplace_back(Vector3f::One);
+        mLocalToWorld.emplace_back(Matrix4::Identity);
+        mChangedVersions.push_back(nextVersion());
+        mComputedVersions.push_back(0);
+        mUpdated.push_back(false);
+
+        // A root does not wait for any parent, so the last level is valid for it until rebuildOrder()
+        if (!mOrderDirty) {
+            if (mLevelOffsets.size() < 2)
+                mLevelOffsets.assign(2, 0);
+            ++mLevelOffsets.back();
+
+            const auto lastLevel = static_cast<uint32_t>(mLevelOffsets.size() - 2);
+            if (canPatchLevels(lastLevel))
+                moveToLevel(mSparse[id], lastLevel, 0);
+        }
+
+        return id;
+    }
+
+    void TransformSystem::reserve(uint32_t _count) {
+        const size_t dense = mNodeIds.size() + _count;
+        if (_count > mFreeIds.size()) {
+            mSparse.reserve(mSparse.size() + (_count - mFreeIds.size()));
+            mDepths.reserve(mSparse.capacity());
+            mFirstChildren.reserve(mSparse.capacity());
+            mNextSiblings.reserve(mSparse.capacity());
+            mPrevSiblings.reserve(mSparse.capacity());
+        }
+
+        mNodeIds.reserve(dense);
+        mParentIds.reserve(dense);
+        mParentIndices.reserve(dense);
+        mPositions.reserve(dense);
+        mRotations.reserve(dense);
+        mScales.reserve(dense);
+        mLocalToWorld.reserve(dense);
+        mChangedVersions.reserve(dense);
+        mComputedVersions.reserve(dense);
+        mUpdated.reserve(dense);
+    }
+
+    void TransformSystem::destroyNode(NodeId _node) {
+        // Children outliving their parent become roots
+        while (mFirstChildren[_node] != InvalidNode)
+            setParent(mFirstChildren[_node], InvalidNode);
+
+        const NodeId parent = mParentIds[mSparse[_node]];
+        if (parent != InvalidNode)
+            unlinkChild(_node, parent);
+
+        // Carry the node down to the last level, whose last slot is the end of the dense arrays
+        const uint32_t last = nodeCount() - 1;
+        const uint32_t lastLevel = mOrderDirty ? 0 : static_cast<uint32_t>(mLevelOffsets.size() - 2);
+        if (!mOrderDirty && canPatchLevels(lastLevel - mDepths[_node] + 1)) {
+            swapNodes(moveToLevel(mSparse[_node], mDepths[_node], lastLevel), last);
+            --mLevelOffsets.back();
+            trimLevels();
+        }
+        else
+            swapNodes(mSparse[_node], last);
+
+        mNodeIds.pop_back();
+        mParentIds.pop_back();
+        mParentIndices.pop_back();
+        mPositions.pop_back();
+        mRotations.pop_back();
+        mScales.pop_back();
+        mLocalToWorld.pop_back();
+        mChangedVersions.pop_back();
+        mComputedVersions.pop_back();
+        mUpdated.pop_back();
+
+        mSparse[_node] = InvalidIndex;
+        mFreeIds.push_back(_node);
+    }
+
+    void TransformSystem::setParent(NodeId _node, NodeId _parent) {
+        const uint32_t index = mSparse[_node];
+        const NodeId oldParent = mParentIds[index];
+        if (oldParent == _parent)
+            return;
+
+        if (oldParent != InvalidNode)
+            unlinkChild(_node, oldParent);
+        if (_parent != InvalidNode)
+            linkChild(_node, _parent);
+
+        mParentIds[index] = _parent;
+        mChangedVersions[index] = nextVersion();
+        if (mOrderDirty)
+            return;
+
+        // Count the subtree only as far as the remaining budget could pay for moving it
+        const uint32_t depth = _parent != InvalidNode ? mDepths[_parent] + 1 : 0;
+        const uint64_t shift = depth > mDepths[_node] ? depth - mDepths[_node] : mDepths[_node] - depth;
+        if (shift != 0) {
+            const uint64_t limit = nodeCount() / shift + 1;
+            if (!canPatchLevels(subtreeSize(_node, limit) * shift))
+                return;
+            setSubtreeDepth(_node, depth);
+        }
+
+        // Read the parent position last, the level swaps may have moved it
+        mParentIndices[mSparse[_node]] = _parent != InvalidNode ? mSparse[_parent] : InvalidIndex;
+    }
+
+    bool TransformSystem::canPatchLevels(uint64_t _swaps) {
+        // Past a rebuild worth of swaps, the rebuild in the next update() is cheaper than patching on
+        if (!mOrderDirty && mPatchedSwaps + _swaps <= nodeCount()) {
+            mPatchedSwaps += _swaps;
+            return true;
+        }
+        mOrderDirty = true;
+        return false;
+    }
+
+    uint64_t TransformSystem::subtreeSize(NodeId _node, uint64_t _limit) {
+        uint64_t size = 0;
+        mSubtreeScratch.assign(1, _node);
+        while (!mSubtreeScratch.empty() && size < _limit) {
+            const NodeId id = mSubtreeScratch.back();
+            mSubtreeScratch.pop_back();
+            ++size;
+            for (NodeId child = mFirstChildren[id]; child != InvalidNode; child = mNextSiblings[child])
+                mSubtreeScratch.push_back(child);
+        }
+        return size;
+    }
+
+    void TransformSystem::setSubtreeDepth(NodeId _node, uint32_t _depth) {
+        if (mDepths[_node] == _depth)
+            return;
+
+        // Every descendant shifts by the same amount of levels, the order they are moved in doesn't matter
+        const int64_t shift = static_cast<int64_t>(_depth) - mDepths[_node];
+        mSubtreeScratch.assign(1, _node);
+        while (!mSubtreeScratch.empty()) {
+            const NodeId id = mSubtreeScratch.back();
+            mSubtreeScratch.pop_back();
+
+            const auto depth = static_cast<uint32_t>(mDepths[id] + shift);
+            moveToLevel(mSparse[id], mDepths[id], depth);
+            mDepths[id] = depth;
+
+            for (NodeId child = mFirstChildren[id]; child != InvalidNode; child = mNextSiblings[child])
+                mSubtreeScratch.push_back(child);
+        }
+        trimLevels();
+    }
+
+    uint32_t TransformSystem::moveToLevel(uint32_t _index, uint32_t _from, uint32_t _to) {
+        // Swapping a node to the end of its level and moving the boundary before it hands it to the next level
+        while (mLevelOffsets.size() < _to + 2)
+            mLevelOffsets.push_back(mLevelOffsets.back());
+
+        for (uint32_t level = _from; level < _to; ++level) {
+            const uint32_t boundary = --mLevelOffsets[level + 1];
+            swapNodes(_index, boundary);
+            _index = boundary;
+        }
+        for (uint32_t level = _from; level > _to; --level) {
+            const uint32_t boundary = mLevelOffsets[level]++;
+            swapNodes(_index, boundary);
+            _index = boundary;
+        }
+        return _index;
+    }
+
+    void TransformSystem::swapNodes(uint32_t _a, uint32_t _b) {
+        if (_a == _b)
+            return;
+
+        std::swap(mNodeIds[_a], mNodeIds[_b]);
+        std::swap(mParentIds[_a], mParentIds[_b]);
+        std::swap(mParentIndices[_a], mParentIndices[_b]);
+        std::swap(mPositions[_a], mPositions[_b]);
+        std::swap(mRotations[_a], mRotations[_b]);
+        std::swap(mScales[_a], mScales[_b]);
+        std::swap(mLocalToWorld[_a], mLocalToWorld[_b]);
+        std::swap(mChangedVersions[_a], mChangedVersions[_b]);
+        std::swap(mComputedVersions[_a], mComputedVersions[_b]);
+        std::swap(mUpdated[_a], mUpdated[_b]);
+        mSparse[mNodeIds[_a]] = _a;
+        mSparse[mNodeIds[_b]] = _b;
+
+        for (const uint32_t index : { _a, _b }) {
+            for (NodeId child = mFirstChildren[mNodeIds[index]]; child != InvalidNode; child = mNextSiblings[child])
+                mParentIndices[mSparse[child]] = index;
+        }
+    }
+
+    void TransformSystem::trimLevels() {
+        while (mLevelOffsets.size() > 2 && mLevelOffsets.back() == mLevelOffsets[mLevelOffsets.size() - 2])
+            mLevelOffsets.pop_back();
+    }
+
+    void TransformSystem::linkChild(NodeId _child, NodeId _parent) {
+        const NodeId first = mFirstChildren[_parent];
+        mPrevSiblings[_child] = InvalidNode;
+        mNextSiblings[_child] = first;
+        if (first != InvalidNode)
+            mPrevSiblings[first] = _child;
+        mFirstChildren[_parent] = _child;
+    }
+
+    void TransformSystem::unlinkChild(NodeId _child, NodeId _parent) {
+        const NodeId prev = mPrevSiblings[_child];
+        const NodeId next = mNextSiblings[_child];
+        if (prev != InvalidNode)
+            mNextSiblings[prev] = next;
+        else
+            mFirstChildren[_parent] = next;
+        if (next != InvalidNode)
+            mPrevSiblings[next] = prev;
+        mPrevSiblings[_child] = InvalidNode;
+        mNextSiblings[_child] = InvalidNode;
+    }
+
+    bool TransformSystem::isDirty(NodeId _node) const {
+        // Dense parent indices are only valid while the order is, go through the sparse table instead
+        uint32_t index = mSparse[_node];
+        const Version computed = mComputedVersions[index];
+        while (true) {
+            if (mChangedVersions[index] > computed)
+                return true;
+            const NodeId parentId = mParentIds[index];
+            if (parentId == InvalidNode)
+                return false;
+            index = mSparse[parentId];
+        }
+    }
+
+    const Matrix4& TransformSystem::getLocalToWorld(NodeId _node) {
+        // Resolving uses mResolveScratch and writes ancestor matrices that other nodes share
+        MX_ASSERT(!mParallelPhase && "World space transforms can't be read by Behaviours running in parallel");
+        const uint32_t index = mSparse[_node];
+        resolve(index);
+        return mLocalToWorld[index];
+    }
+
+    void TransformSystem::resolve(uint32_t _index) {
+        // Collect the ancestor chain, then walk it back from the root
+        mResolveScratch.clear();
+        for (uint32_t index = _index;;) {
+            mResolveScratch.push_back(index);
+            const NodeId parentId = mParentIds[index];
+            if (parentId == InvalidNode)
+                break;
+            index = mSparse[parentId];
+        }
+
+        Version chain = 0;
+        uint32_t parent = InvalidIndex;
+        for (auto it = mResolveScratch.rbegin(); it != mResolveScratch.rend(); ++it) {
+            const uint32_t index = *it;
+            chain = std::max(chain, mChangedVersions[index]);
+            if (chain > mComputedVersions[index]) {
+                mLocalToWorld[index] = Matrix4::TRS(mPositions[index], mRotations[index], mScales[index]);
+                if (parent != InvalidIndex)
+                    mLocalToWorld[index] = mLocalToWorld[parent] * mLocalToWorld[index];
+                mComputedVersions[index] = mVersion;
+            }
+            parent = index;
+        }
+    }
+
+    void TransformSystem::rebuildOrder() {
+        const uint32_t count = nodeCount();
+        constexpr uint32_t unknown = InvalidIndex;
+
+        // Compute the depth of every node, walking up each chain at most once
+        mDepthScratch.assign(count, unknown);
+        uint32_t maxDepth = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t curr = i;
+            while (mDepthScratch[curr] == unknown) {
+                const NodeId parentId = mParentIds[curr];
+                if (parentId == InvalidNode) {
+                    mDepthScratch[curr] = 0;
+                    break;
+                }
+                mStackScratch.push_back(curr);
+                curr = mSparse[parentId];
+            }
+
+            uint32_t depth = mDepthScratch[curr];
+            while (!mStackScratch.empty()) {
+                mDepthScratch[mStackScratch.back()] = ++depth;
+                mStackScratch.pop_back();
+            }
+            maxDepth = std::max(maxDepth, mDepthScratch[i]);
+        }
+
+        // Counting sort by depth, stable so that siblings keep their relative order
+        mLevelOffsets.assign(maxDepth + 2, 0);
+        for (uint32_t i = 0; i < count; ++i)
+            ++mLevelOffsets[mDepthScratch[i] + 1];
+        for (uint32_t d = 1; d < mLevelOffsets.size(); ++d)
+            mLevelOffsets[d] += mLevelOffsets[d - 1];
+
+        mCursorScratch.assign(mLevelOffsets.begin(), mLevelOffsets.end());
+        mPermScratch.resize(count);
+        for (uint32_t i = 0; i < count; ++i)
+            mPermScratch[mCursorScratch[mDepthScratch[i]]++] = i;
+
+        // Copy back instead of swapping so that the capacity given by reserve() is kept
+        auto gather = [this, count](auto& _array, auto& _scratch) {
+            _scratch.clear();
+            for (uint32_t i = 0; i < count; ++i)
+                _scratch.push_back(_array[mPermScratch[i]]);
+            std::copy(_scratch.begin(), _scratch.end(), _array.begin());
+        };
+
+        gather(mNodeIds, mGatherIds);
+        gather(mParentIds, mGatherIds);
+        gather(mPositions, mGatherVectors);
+        gather(mRotations, mGatherRotations);
+        gather(mScales, mGatherVectors);
+        gather(mLocalToWorld, mGatherMatrices);
+        gather(mChangedVersions, mGatherVersions);
+        gather(mComputedVersions, mGatherVersions);
+        gather(mUpdated, mGatherFlags);
+
+        for (uint32_t i = 0; i < count; ++i)
+            mSparse[mNodeIds[i]] = i;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            mParentIndices[i] = mParentIds[i] != InvalidNode ? mSparse[mParentIds[i]] : InvalidIndex;
+            mDepths[mNodeIds[i]] = mDepthScratch[mPermScratch[i]];
+        }
+
+        mOrderDirty = false;
+    }
+}
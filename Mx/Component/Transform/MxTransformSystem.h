@@ -0,0 +1,251 @@
+#pragma once
+
+#ifndef MX_TRANSFORM_SYSTEM_H_
+#define MX_TRANSFORM_SYSTEM_H_
+
+#include "../../Engine/MxModuleBase.h"
+#include "../../Math/MxMatrix4.h"
+#include "../../Math/MxQuaternion.h"
+#include <atomic>
+#include <vector>
+#include <limits>
+
+namespace Mix {
+    /**
+     * \brief Dense storage of every Transform in the engine.
+     *
+     *        Local TRS and world matrices are kept in structure-of-arrays form. The arrays are ordered
+     *        so that a parent always comes before its children (nodes are sorted by hierarchy depth),
+     *        which allows all dirty world matrices to be recomputed in one linear pass per frame. Nodes
+     *        of the same depth are independent of each other, so each depth level is processed in
+     *        parallel on the ThreadPool.
+     *
+     *        Nodes are referred to by a stable NodeId, the position of a node in the dense arrays
+     *        may change whenever the hierarchy is modified. Hierarchy changes patch the levels in place
+     *        with swaps at the level boundaries, so their cost depends on the moved subtree and on the
+     *        levels it crosses rather than on the amount of nodes. Once the swaps since the last update()
+     *        add up to the amount of nodes, the order is rebuilt in one pass by the next update() instead.
+     *
+     *        Dirty tracking uses version numbers instead of flags on every descendant. A change only stamps
+     *        the modified node, a world matrix is out of date when any node on its ancestor chain was stamped
+     *        after the matrix was computed. Setters are O(1) and propagation happens in the bulk pass.
+     *        Local TRS setters of different nodes may be called concurrently, world matrix getters may not:
+     *        resolving a node writes the matrices of its ancestors, which other nodes share. getLocalToWorld()
+     *        asserts when called while Behaviours run in parallel, getCachedLocalToWorld() stays allowed.
+     */
+    class TransformSystem final : public ModuleBase {
+    public:
+        using NodeId = uint32_t;
+
+        static constexpr NodeId InvalidNode = std::numeric_limits<NodeId>::max();
+
+        static TransformSystem* Get();
+
+        TransformSystem() = default;
+
+        ~TransformSystem() = default;
+
+        void load() override {}
+
+        void init() override {}
+
+        /** \brief Recompute the world matrices of all dirty nodes. Called once per frame before rendering. */
+        void update();
+
+        /** \brief Create a new root node with identity local transform. */
+        NodeId createNode();
+
+        /**
+         * \brief Destroy a node. The id may be reused afterwards.
+         * \note  Children should be detached or destroyed before their parent.
+         */
+        void destroyNode(NodeId _node);
+
+        /** \brief Make sure the next _count nodes can be created without reallocating the dense arrays. */
+        void reserve(uint32_t _count);
+
+        /** \brief Get the amount of alive nodes. */
+        uint32_t nodeCount() const { return static_cast<uint32_t>(mNodeIds.size()); }
+
+        //////////////////////////////////////////////////////////////////
+        //                          Hierarchy                           //
+        //////////////////////////////////////////////////////////////////
+
+        /** \brief Set the parent of a node, InvalidNode makes the node a root. */
+        void setParent(NodeId _node, NodeId _parent);
+
+        NodeId getParent(NodeId _node) const { return mParentIds[mSparse[_node]]; }
+
+        //////////////////////////////////////////////////////////////////
+        //                          Local TRS                           //
+        //////////////////////////////////////////////////////////////////
+
+        const Vector3f& getLocalPosition(NodeId _node) const { return mPositions[mSparse[_node]]; }
+
+        const Quaternion& getLocalRotation(NodeId _node) const { return mRotations[mSparse[_node]]; }
+
+        const Vector3f& getLocalScale(NodeId _node) const { return mScales[mSparse[_node]]; }
+
+        void setLocalPosition(NodeId _node, const Vector3f& _pos) {
+            const uint32_t index = mSparse[_node];
+            mPositions[index] = _pos;
+            mChangedVersions[index] = nextVersion();
+        }
+
+        void setLocalRotation(NodeId _node, const Quaternion& _qua) {
+            const uint32_t index = mSparse[_node];
+            mRotations[index] = _qua;
+            mChangedVersions[index] = nextVersion();
+        }
+
+        void setLocalScale(NodeId _node, const Vector3f& _scale) {
+            const uint32_t index = mSparse[_node];
+            mScales[index] = _scale;
+            mChangedVersions[index] = nextVersion();
+        }
+
+        //////////////////////////////////////////////////////////////////
+        //                         World matrix                         //
+        //////////////////////////////////////////////////////////////////
+
+        /** \brief Mark the world matrix of a node and all its descendants as out of date. */
+        void markDirty(NodeId _node) { mChangedVersions[mSparse[_node]] = nextVersion(); }
+
+        /** \brief Check whether the world matrix of a node is out of date. Walks the ancestor chain without allocating. */
+        bool isDirty(NodeId _node) const;
+
+        /** \brief Check whether the world matrix of a node was recomputed by the last update(). */
+        bool wasUpdated(NodeId _node) const { return mUpdated[mSparse[_node]]; }
+
+        /** \brief Get the nodes whose world matrix was recomputed by the last update(), in no particular order. */
+        const std::vector<NodeId>& getUpdatedNodes() const { return mUpdatedNodes; }
+
+        /**
+         * \brief Get the local to world matrix of a node, recomputing it on demand if it is dirty.
+         * \note  The reference stays valid until the next node is created or destroyed. Must not be called
+         *        during a parallel phase, see _setParallelPhase().
+         */
+        const Matrix4& getLocalToWorld(NodeId _node);
+
+        /**
+         * \brief Get the local to world matrix computed by the last update() without resolving it.
+         *        Has no side effect, so it is safe to call from several threads during rendering.
+         */
+        const Matrix4& getCachedLocalToWorld(NodeId _node) const { return mLocalToWorld[mSparse[_node]]; }
+
+        /** \brief Called by the Scene around the hooks it runs on worker threads, getLocalToWorld() asserts in between. */
+        void _setParallelPhase(bool _parallel) { mParallelPhase = _parallel; }
+
+    private:
+        static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        using Version = uint64_t;
+
+        /** \brief Get a fresh version. Local TRS setters may be called from parallel Behaviour updates. */
+        Version nextVersion() { return mVersion.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+        /** \brief Recompute the world matrix of the node at _index and its out of date ancestors. */
+        void resolve(uint32_t _index);
+
+        /** \brief Sort nodes by depth so that parents precede their children. */
+        void rebuildOrder();
+
+        /**
+         * \brief Account for _swaps level boundary swaps, or give up patching until the next rebuildOrder().
+         * \return Whether the levels are valid and may be patched.
+         */
+        bool canPatchLevels(uint64_t _swaps);
+
+        /** \brief Count the nodes in the subtree of _node, stops counting at _limit. */
+        uint64_t subtreeSize(NodeId _node, uint64_t _limit);
+
+        /** \brief Swap two dense slots, keeping mSparse and the parent indices of their children up to date. */
+        void swapNodes(uint32_t _a, uint32_t _b);
+
+        /**
+         * \brief Carry the node at _index from level _from to level _to, swapping it over one level boundary at a time.
+         * \return The new dense index of the node.
+         */
+        uint32_t moveToLevel(uint32_t _index, uint32_t _from, uint32_t _to);
+
+        /** \brief Move _node to level _depth and its descendants along with it. */
+        void setSubtreeDepth(NodeId _node, uint32_t _depth);
+
+        /** \brief Drop the empty levels at the end of mLevelOffsets. */
+        void trimLevels();
+
+        void linkChild(NodeId _child, NodeId _parent);
+
+        void unlinkChild(NodeId _child, NodeId _parent);
+
+        /** \brief Bulk pass body for the node at _index, its parent must have been processed already. */
+        void updateNode(uint32_t _index);
+
+        /** \brief Nodes per parallel task during update(). */
+        static constexpr uint32_t UpdateGrainSize = 256;
+
+        // NodeId -> dense index
+        std::vector<uint32_t> mSparse;
+        std::vector<NodeId> mFreeIds;
+
+        // Indexed by NodeId, so that they don't move with the dense arrays. Children form a doubly linked list.
+        std::vector<uint32_t> mDepths;
+        std::vector<NodeId> mFirstChildren;
+        std::vector<NodeId> mNextSiblings;
+        std::vector<NodeId> mPrevSiblings;
+
+        // Dense arrays, all indexed by the same dense index
+        std::vector<NodeId> mNodeIds;
+        std::vector<NodeId> mParentIds;
+        std::vector<uint32_t> mParentIndices;
+        std::vector<Vector3f> mPositions;
+        std::vector<Quaternion> mRotations;
+        std::vector<Vector3f> mScales;
+        std::vector<Matrix4> mLocalToWorld;
+        std::vector<Version> mChangedVersions;
+        std::vector<Version> mComputedVersions;
+        std::vector<uint8_t> mUpdated;
+
+        /** \brief Ids of the nodes flagged in mUpdated, collected at the end of update(). */
+        std::vector<NodeId> mUpdatedNodes;
+
+        /** \brief Bumped on every change, a version is never reused. */
+        std::atomic<Version> mVersion{ 0 };
+
+        /** \brief mVersion at the start of the last update(). */
+        Version mLastUpdateVersion = 0;
+
+        /** \brief Set while Behaviours run on worker threads, world matrices can't be resolved then. */
+        bool mParallelPhase = false;
+
+        /** \brief Set when the levels no longer match the depths, rebuildOrder() restores them. */
+        bool mOrderDirty = false;
+
+        /** \brief Level boundary swaps done since the last update(). */
+        uint64_t mPatchedSwaps = 0;
+
+        /**
+         * \brief Level l is stored in [mLevelOffsets[l], mLevelOffsets[l + 1]) and holds the nodes of depth l,
+         *        plus the roots created since the order got dirty in the last level.
+         */
+        std::vector<uint32_t> mLevelOffsets;
+
+        std::vector<NodeId> mSubtreeScratch;
+
+        // Scratch buffers reused by rebuildOrder()
+        std::vector<uint32_t> mDepthScratch;
+        std::vector<uint32_t> mStackScratch;
+        std::vector<uint32_t> mCursorScratch;
+        std::vector<uint32_t> mPermScratch;
+        std::vector<NodeId> mGatherIds;
+        std::vector<Vector3f> mGatherVectors;
+        std::vector<Quaternion> mGatherRotations;
+        std::vector<Matrix4> mGatherMatrices;
+        std::vector<Version> mGatherVersions;
+        std::vector<uint8_t> mGatherFlags;
+        std::vector<Version> mChainScratch;
+        std::vector<uint32_t> mResolveScratch;
+    };
+}
+
+#endif
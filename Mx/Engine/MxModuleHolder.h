@@ -37,7 +37,8 @@ namespace Mix {
 
 			mModules.emplace(std::type_index(typeid(_Ty)), std::make_unique<_Ty>(std::forward<_Args>(_args)...));
 			mAddOrder.push_back(std::type_index(typeid(_Ty)));
-			return dynamic_cast<_Ty*>(mModules[std::type_index(typeid(_Ty))].get());
+			// The map is keyed by the exact type, no need for a dynamic_cast
+			return static_cast<_Ty*>(mModules[std::type_index(typeid(_Ty))].get());
 		}
 
 		template<typename _Ty>
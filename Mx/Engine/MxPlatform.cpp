@@ -200,14 +200,14 @@ namespace Mix {
     bool Platform::sRelativeMouseMode = false;
     std::string Platform::sPlantformName = "Unknown";
 
-    Event<void(const PFMouseMoveEventData&)>		Platform::MouseMoveEvent;
-    Event<void(const PFMouseButtonEventData&)>		Platform::MouseButtonEvent;
-    Event<void(const PFMouseWheelEventData&)>		Platform::MouseWheelEvent;
-    Event<void(const PFKeyboardEventData&)>			Platform::KeyboardEvent;
-    Event<void(const PFGamepadAxisEventData&)>		Platform::GamepadAxisEvent;
-    Event<void(const PFGamepadButtonEventData&)>	Platform::GamepadButtonEvent;
-    Event<void(const PFGamepadDeviceEventData&)>	Platform::GamepadDeviceEvent;
-    Event<void()>									Platform::QuitEvent;
+    LocalEvent<void(const PFMouseMoveEventData&)>		Platform::MouseMoveEvent;
+    LocalEvent<void(const PFMouseButtonEventData&)>		Platform::MouseButtonEvent;
+    LocalEvent<void(const PFMouseWheelEventData&)>		Platform::MouseWheelEvent;
+    LocalEvent<void(const PFKeyboardEventData&)>		Platform::KeyboardEvent;
+    LocalEvent<void(const PFGamepadAxisEventData&)>		Platform::GamepadAxisEvent;
+    LocalEvent<void(const PFGamepadButtonEventData&)>	Platform::GamepadButtonEvent;
+    LocalEvent<void(const PFGamepadDeviceEventData&)>	Platform::GamepadDeviceEvent;
+    LocalEvent<void()>									Platform::QuitEvent;
 
     bool Platform::Initialize() {
         if (!sInitialized) {
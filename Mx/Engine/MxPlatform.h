@@ -3,7 +3,7 @@
 #define MX_PLANTFORM_H_
 
 #include "../Utils/MxGeneralBase.hpp"
-#include "../Utils/MxEvent.h"
+#include "../Utils/MxLocalEvent.h"
 #include "../Input/MxKeyCode.h"
 
 namespace Mix {
@@ -130,21 +130,21 @@ namespace Mix {
         static void Sleep(uint32_t _duration);
 
 		// Events
-		static Event<void(const PFMouseMoveEventData&)> MouseMoveEvent;
+		static LocalEvent<void(const PFMouseMoveEventData&)> MouseMoveEvent;
 
-		static Event<void(const PFMouseButtonEventData&)> MouseButtonEvent;
+		static LocalEvent<void(const PFMouseButtonEventData&)> MouseButtonEvent;
 
-		static Event<void(const PFMouseWheelEventData&)> MouseWheelEvent;
+		static LocalEvent<void(const PFMouseWheelEventData&)> MouseWheelEvent;
 
-		static Event<void(const PFKeyboardEventData&)> KeyboardEvent;
+		static LocalEvent<void(const PFKeyboardEventData&)> KeyboardEvent;
 
-		static Event<void(const PFGamepadAxisEventData&)> GamepadAxisEvent;
+		static LocalEvent<void(const PFGamepadAxisEventData&)> GamepadAxisEvent;
 
-		static Event<void(const PFGamepadButtonEventData&)> GamepadButtonEvent;
+		static LocalEvent<void(const PFGamepadButtonEventData&)> GamepadButtonEvent;
 
-		static Event<void(const PFGamepadDeviceEventData&)> GamepadDeviceEvent;
+		static LocalEvent<void(const PFGamepadDeviceEventData&)> GamepadDeviceEvent;
 
-		static Event<void()> QuitEvent;
+		static LocalEvent<void()> QuitEvent;
 	private:
 		static void PollEvent();
 
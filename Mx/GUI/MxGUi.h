@@ -9,6 +9,7 @@
 #include "../../ThirdPartyLibs/imgui/imgui.h"
 #include "../Definitions/MxCommonEnum.h"
 #include "../Input/MxMouse.h"
+#include "../Utils/MxLocalEvent.h"
 
 namespace Mix {
     class Texture2D;
@@ -47,7 +48,7 @@ namespace Mix {
 
         void endGUI();
 
-        Event<void()> GUIEvent;
+        LocalEvent<void()> GUIEvent;
 
     private:
         void setImGui();
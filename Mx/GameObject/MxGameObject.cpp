@@ -1,7 +1,10 @@
 #include "MxGameObject.h"
 #include <algorithm>
+#include <limits>
 #include "../Scene/MxSceneManager.h"
 #include "../Component/MxComponent.h"
+#include "../Component/Renderer/MxRenderer.h"
+#include "../Component/MeshFilter/MxMeshFilter.h"
 #include "../Log/MxLog.h"
 
 namespace Mix {
@@ -30,34 +33,87 @@ namespace Mix {
             mParent = nullptr;
         }
 
+        // Components are told about the deactivation before they are destroyed
         setActive(false);
+        if (mScene)
+            mScene->flushActivationChanges();
 
         destroyInternal(mThisHandle, _immediate);
     }
 
     void GameObject::destroyInternal(SceneObjectHandleBase& _handle, bool _immediate) {
-        if (_immediate) {
-            // Remove children
-            for (auto iter = mChildren.begin(); iter != mChildren.end(); ++iter)
-                (*iter)->destroyInternal(*iter, true);
-
-            mChildren.clear();
-
-            if (mScene)
-                mScene->unregisterGameObject(mThisHandle);
+        if (_immediate)
+            destroyHierarchy();
+        else
+            SceneObjectManager::Get()->pushToDestroyQueue(_handle);
+    }
 
-            // Remove component
-            while (!mComponents.empty()) {
-                auto& component = mComponents.back();
-                component->destroyInternal(component, true);
-                mComponents.erase(mComponents.end() - 1);
+    void GameObject::destroyHierarchy() {
+        // Pre-order, a parent always precedes its descendants
+        std::vector<GameObject*> objects{ this };
+        size_t componentCount = 0;
+        for (size_t i = 0; i < objects.size(); ++i) {
+            componentCount += objects[i]->mComponents.size();
+            for (auto& child : objects[i]->mChildren) {
+                if (auto ptr = child._getPtr())
+                    objects.push_back(static_cast<GameObject*>(ptr));
             }
+        }
 
-            SceneObjectManager::Get()->unregisterObject(_handle);
+        // Behaviours and Renderers leave the scene here, their destructors won't reach it any more
+        for (auto object : objects) {
+            if (object->mScene)
+                object->mScene->unregisterGameObject(object->mThisHandle);
         }
-        else {
-            SceneObjectManager::Get()->pushToDestroyQueue(_handle);
+
+        // Bucket Components by type, children first within a type so Transform nodes are leaves when destroyed
+        std::vector<uint32_t> typeOffsets(Rtti::Count() + 1, 0);
+        for (auto object : objects) {
+            for (auto& component : object->mComponents)
+                ++typeOffsets[component._getPtr()->getType().getId() + 1];
         }
+        for (size_t i = 1; i < typeOffsets.size(); ++i)
+            typeOffsets[i] += typeOffsets[i - 1];
+
+        std::vector<SceneObjectHandleBase> handles(componentCount);
+        for (auto it = objects.rbegin(); it != objects.rend(); ++it) {
+            GameObject* object = *it;
+            for (auto& component : object->mComponents)
+                handles[typeOffsets[component._getPtr()->getType().getId()]++] = component;
+            object->mComponents.clear();
+            object->mComponentSlots.clear();
+        }
+
+        handles.reserve(componentCount + objects.size());
+        for (auto it = objects.rbegin(); it != objects.rend(); ++it)
+            handles.push_back((*it)->mThisHandle);
+
+        // This GameObject is deleted in here as well
+        SceneObjectManager::Get()->unregisterObjects(handles);
+    }
+
+    void GameObject::setName(const std::string& _name) {
+        if (mScene)
+            mScene->unindexGameObject(*this);
+        mName = _name;
+        if (mScene)
+            mScene->indexGameObject(*this);
+    }
+
+    void GameObject::setTag(const Tag& _tag) {
+        if (mScene)
+            mScene->unindexGameObject(*this);
+        mTag = _tag;
+        if (mScene)
+            mScene->indexGameObject(*this);
+    }
+
+    void GameObject::setLayer(LayerIndex _layer) {
+        if (mScene)
+            mScene->unindexGameObject(*this);
+        mLayer = _layer;
+        if (mScene)
+            mScene->indexGameObject(*this);
     }
 
     void GameObject::_setFlags(Flags<GameObjectFlags> _flags) {
@@ -116,20 +172,53 @@ namespace Mix {
         return gameObject;
     }
 
+    HGameObject GameObject::CreateInHierarchy(const std::shared_ptr<Scene>& _scene, const HGameObject& _parent, const std::string& _name, const Tag& _tag, LayerIndex _layerIndex, Flags<GameObjectFlags> _flags) {
+        auto ptr = std::shared_ptr<GameObject>(new GameObject(_name, _tag, _layerIndex, _flags));
+        ptr->mUUID = UUID::RandomUUID();
+
+        HGameObject gameObject = static_scene_object_cast<GameObject>(SceneObjectManager::Get()->registerObject(ptr));
+        gameObject->mThisHandle = gameObject;
+        gameObject->addComponent<Transform>();
+        gameObject->mTransform = static_scene_object_cast<Transform>(gameObject->mComponents[0]);
+
+        if (_parent) {
+            gameObject->mParent = _parent;
+            gameObject->mActiveInHierarchy = _parent->mActiveInHierarchy;
+            gameObject->mActiveNotified = gameObject->mActiveInHierarchy;
+            _parent->mChildren.push_back(gameObject);
+            gameObject->transform().setParentInternal(&_parent->transform());
+            gameObject->setScene(_parent->mScene);
+        }
+        else if (_scene)
+            gameObject->setScene(_scene);
+
+        return gameObject;
+    }
+
     void GameObject::removeComponent(const HComponent& _component, bool _immediate) {
         auto it = std::find(mComponents.begin(), mComponents.end(), _component);
 
         if (it != mComponents.end()) {
-            (*it)->_setIsDestroyed();
-
-            if (_component->isDerived(Behaviour::GetType())) {
-                // mBehaviours.erase(std::find(mBehaviours.begin(), mBehaviours.end(), static_scene_object_cast<Behaviour>(_component)));
-                mScene->unregisterBehaviour(static_scene_object_cast<Behaviour>(_component));
+            // The handle can't be dereferenced once the Component is marked as destroyed
+            Component* component = it->operator->();
+            component->_setIsDestroyed();
+
+            if (mScene) {
+                if (auto behaviour = rtti_cast<Behaviour>(component))
+                    mScene->unregisterBehaviour(behaviour);
+                if (auto renderer = rtti_cast<Renderer>(component))
+                    mScene->unregisterRenderer(renderer);
             }
 
+            // The Renderers keep drawing the Mesh of a removed MeshFilter until their elements are rebuilt
+            if (rtti_cast<MeshFilter>(component))
+                forEachComponent<Renderer>([](Renderer& _renderer) { _renderer._markRenderElementsDirty(); });
+
             (*it)->destroyInternal(*it, _immediate);
 
             mComponents.erase(it);
+            rebuildComponentSlots();
+            return;
         }
 
         Log::Warning("Trying to remove a component that isn't attached to this GameObject");
@@ -144,22 +233,42 @@ namespace Mix {
         _component->mGameObject = mThisHandle;
 
         mComponents.push_back(_component);
+        registerComponentSlots(static_cast<uint32_t>(mComponents.size() - 1));
 
         if (_component->isDerived(Behaviour::GetType())) {
             // mBehaviours.push_back(static_scene_object_cast<Behaviour>(_component));
             mScene->registerBehaviour(static_scene_object_cast<Behaviour>(_component));
         }
+
+        if (mScene) {
+            if (auto renderer = rtti_cast<Renderer>(_component.operator->()))
+                mScene->registerRenderer(renderer);
+        }
     }
 
     HComponent GameObject::getComponent(const Rtti& _type) const {
-        if (_type.isDerivedFrom(Component::GetType())) {
-            for (auto& comp : mComponents) {
-                if (comp->getType().isSameType(_type) || comp->getType().isDerivedFrom(_type))
-                    return comp;
-            }
+        const int index = firstComponentIndex(_type);
+        return index >= 0 ? mComponents[index] : HComponent();
+    }
+
+    void GameObject::registerComponentSlots(uint32_t _index) {
+        if (mComponentSlots.size() < Rtti::Count())
+            mComponentSlots.resize(Rtti::Count(), 0);
+
+        // Walk up to Component, bases above it can never be queried
+        for (const Rtti* type = &mComponents[_index]->getType(); type; type = type->getBase()) {
+            auto& slot = mComponentSlots[type->getId()];
+            if (slot == 0)
+                slot = static_cast<uint16_t>(_index + 1);
+            if (type->isSameType(Component::GetType()))
+                break;
         }
+    }
 
-        return HComponent();
+    void GameObject::rebuildComponentSlots() {
+        std::fill(mComponentSlots.begin(), mComponentSlots.end(), static_cast<uint16_t>(0));
+        for (uint32_t i = 0; i < mComponents.size(); ++i)
+            registerComponentSlots(i);
     }
 
     void GameObject::setParent(const HGameObject& _parent, bool _keepWorldTransform) {
@@ -177,10 +286,12 @@ namespace Mix {
 
             mParent->removeChild(mThisHandle);
             mParent = nullptr;
+            transform().setParentInternal(nullptr);
             transform().setPosition(position);
             transform().setRotation(rotation);
 
             mScene->rootGameObjectChanged(mThisHandle);
+            updateActiveInHierarchy();
         }
 
         if (_parent.isDestroyed()) {
@@ -213,11 +324,14 @@ namespace Mix {
 
         mParent = _parent;
         mParent->addChild(mThisHandle);
+        transform().setParentInternal(&mParent->transform());
         setScene(mParent->mScene);
 
         if (parentIsNull)
             mScene->rootGameObjectChanged(mThisHandle);
 
+        updateActiveInHierarchy();
+
         if (_keepWorldTransform) {
             transform().setPosition(position);
             transform().setRotation(rotation);
@@ -275,34 +389,98 @@ namespace Mix {
     }
 
     HGameObject GameObject::findChild(const std::string& _name, bool _recursive) {
-        for (auto& child : mChildren) {
-            if (child->getName() == _name)
-                return child;
-        }
-
-        if (_recursive) {
+        if (!_recursive) {
             for (auto& child : mChildren) {
-                auto found = child->findChild(_name, true);
-                if (found != nullptr)
-                    return found;
+                if (child->getName() == _name)
+                    return child;
             }
+            return HGameObject();
         }
-        return HGameObject();
+
+        std::vector<HGameObject> results;
+        findDescendants(_name, true, results);
+        return results.empty() ? HGameObject() : results.front();
     }
 
     std::vector<HGameObject> GameObject::findChildren(const std::string& _name, bool _recursive) {
         std::vector<HGameObject> results;
+        if (!_recursive) {
+            for (auto& child : mChildren) {
+                if (child->getName() == _name)
+                    results.push_back(child);
+            }
+            return results;
+        }
+
+        findDescendants(_name, false, results);
+        return results;
+    }
 
-        for (auto& child : mChildren) {
-            if (child->getName() == _name)
-                results.push_back(child);
+    void GameObject::findDescendants(const std::string& _name, bool _firstOnly, std::vector<HGameObject>& _results) const {
+        const std::vector<HGameObject>* bucket = mScene ? &mScene->findGameObjectsWithName(_name) : nullptr;
+        if (bucket && bucket->empty())
+            return;
 
-            if (_recursive) {
-                auto found = child->findChildren(_name, _recursive);
-                results.insert(results.end(), found.begin(), found.end());
+        // Walk the subtree in child order, but give up once it turns out larger than the name bucket
+        size_t budget = bucket ? bucket->size() : std::numeric_limits<size_t>::max();
+        std::vector<const HGameObject*> stack;
+        for (auto it = mChildren.rbegin(); it != mChildren.rend(); ++it)
+            stack.push_back(&*it);
+
+        while (!stack.empty() && budget != 0) {
+            const HGameObject& object = *stack.back();
+            stack.pop_back();
+            --budget;
+
+            if (object->getName() == _name) {
+                _results.push_back(object);
+                if (_firstOnly)
+                    return;
             }
+            for (auto it = object->mChildren.rbegin(); it != object->mChildren.rend(); ++it)
+                stack.push_back(&*it);
         }
-        return results;
+        if (stack.empty())
+            return;
+
+        // The bucket is smaller, filter it by ancestry and sort the hits back into child order
+        _results.clear();
+        std::vector<std::pair<std::vector<uint32_t>, HGameObject>> hits;
+        for (auto& object : *bucket) {
+            if (object->isDescendantOf(this))
+                hits.emplace_back(object->childPath(this), object);
+        }
+
+        if (_firstOnly) {
+            auto first = std::min_element(hits.begin(), hits.end(), [](const auto& _a, const auto& _b) { return _a.first < _b.first; });
+            if (first != hits.end())
+                _results.push_back(first->second);
+            return;
+        }
+
+        std::sort(hits.begin(), hits.end(), [](const auto& _a, const auto& _b) { return _a.first < _b.first; });
+        _results.reserve(hits.size());
+        for (auto& hit : hits)
+            _results.push_back(std::move(hit.second));
+    }
+
+    std::vector<uint32_t> GameObject::childPath(const GameObject* _ancestor) const {
+        std::vector<uint32_t> path;
+        for (const GameObject* object = this; object != _ancestor; object = object->mParent.operator->()) {
+            const auto& siblings = object->mParent->mChildren;
+            const auto it = std::find_if(siblings.begin(), siblings.end(), [object](const HGameObject& _sibling) { return _sibling.operator->() == object; });
+            path.push_back(static_cast<uint32_t>(it - siblings.begin()));
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    bool GameObject::isDescendantOf(const GameObject* _ancestor) const {
+        for (auto parent = mParent; parent != nullptr; parent = parent->mParent) {
+            if (parent.operator->() == _ancestor)
+                return true;
+        }
+        return false;
     }
 
     void GameObject::setActive(const bool _active) {
@@ -310,27 +488,26 @@ namespace Mix {
             return;
 
         mActiveSelf = _active;
-        const bool activedInHierarchy = mActiveInHierarchy;
+        updateActiveInHierarchy();
+    }
 
-        if (mActiveSelf && mParent)
-            mActiveInHierarchy = mParent->mActiveInHierarchy;
-        else
-            mActiveInHierarchy = mActiveSelf;
+    void GameObject::updateActiveInHierarchy() {
+        // Only descend below the objects whose state actually changed
+        std::vector<GameObject*> stack{ this };
+        while (!stack.empty()) {
+            GameObject* object = stack.back();
+            stack.pop_back();
 
-        if (mActiveInHierarchy == activedInHierarchy)
-            return;
+            const bool active = object->mActiveSelf && (!object->mParent || object->mParent->mActiveInHierarchy);
+            if (active == object->mActiveInHierarchy)
+                continue;
 
-        for (auto child : mChildren)
-            child->setActive(child->mActiveSelf);
+            object->mActiveInHierarchy = active;
+            if (object->mScene)
+                object->mScene->queueActivationChange(*object);
 
-        auto behaviours = getComponents<Behaviour>();
-        if (mActiveSelf) {
-            for (auto& behaviour : behaviours)
-                behaviour->onEnableInternal();
-        }
-        else {
-            for (auto& behaviour : behaviours)
-                behaviour->onDisableInternal();
+            for (auto& child : object->mChildren)
+                stack.push_back(child.operator->());
         }
     }
 
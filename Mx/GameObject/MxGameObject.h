@@ -5,6 +5,7 @@
 
 #include "../Component/Behaviour/MxBehaviour.h"
 #include "../Component/Transform/MxTransform.h"
+#include "../Component/MxComponentPool.h"
 #include "../Scene/MxSceneObject.h"
 #include "../Scene/MxSceneObjectManager.h"
 #include <set>
@@ -32,6 +33,8 @@ namespace Mix {
         friend SceneManager;
         friend SceneFiller;
         friend Model;
+        friend class SceneFileLoader;
+        friend class Prefab;
 
     public:
         ~GameObject();
@@ -44,6 +47,9 @@ namespace Mix {
 
         HGameObject getHandle() const { return mThisHandle; }
 
+        /** \brief Rename this GameObject, the name index of its Scene is updated. */
+        void setName(const std::string& _name) override;
+
         GameObject(const GameObject& _obj) = delete;
 
         GameObject& operator=(const GameObject& _obj) = delete;
@@ -64,8 +70,20 @@ namespace Mix {
 
         static HGameObject CreateInternal(const HGameObject& _parent, const std::string& _name, const Tag& _tag = "", LayerIndex _layerIndex = 0, Flags<GameObjectFlags> _flags = {});
 
+        /**
+         * \brief Create a GameObject directly under _parent, or as a root of _scene if _parent is null.
+         *        Unlike setParent() the local transform is kept as is, used when a whole hierarchy is built at once.
+         */
+        static HGameObject CreateInHierarchy(const std::shared_ptr<Scene>& _scene, const HGameObject& _parent, const std::string& _name, const Tag& _tag, LayerIndex _layerIndex, Flags<GameObjectFlags> _flags);
+
         void destroyInternal(SceneObjectHandleBase& _handle, bool _immediate = false) override;
 
+        /**
+         * \brief Destroy this GameObject and all its descendants right away. The subtree leaves its Scene,
+         *        Components are released grouped by type and all slots are freed in one sweep.
+         */
+        void destroyHierarchy();
+
         HGameObject mThisHandle;
         Flags<GameObjectFlags> mFlags;
 
@@ -99,6 +117,13 @@ namespace Mix {
         template<typename _Ty>
         std::vector<SceneObjectHandle<_Ty>> getComponents();
 
+        /**
+         *  @brief Call _func(_Ty&) for every Component of type _Ty attached to this GameObject without allocating.
+         *  @note  Components must not be added or removed by _func.
+         */
+        template<typename _Ty, typename _Func>
+        void forEachComponent(_Func&& _func);
+
         /**
          *  @brief Check if a components of Specified type is attached to this GameObject.
          *  @return True if the object has a component of specified type.
@@ -123,7 +148,23 @@ namespace Mix {
 
         HComponent getComponent(const Rtti& _type) const;
 
+        /** \brief Get the index into mComponents of the first Component of _type, or -1 if there is none. */
+        int firstComponentIndex(const Rtti& _type) const {
+            return _type.getId() < mComponentSlots.size() ? static_cast<int>(mComponentSlots[_type.getId()]) - 1 : -1;
+        }
+
+        /** \brief Record the Component at _index for its own type and all its base types. */
+        void registerComponentSlots(uint32_t _index);
+
+        void rebuildComponentSlots();
+
         std::vector<HComponent> mComponents;
+
+        /**
+         * \brief Type mask and slot table in one: indexed by Rtti::getId(), holds 1 + the index of the
+         *        first Component of that type (exact or derived) in mComponents, 0 if there is none.
+         */
+        std::vector<uint16_t> mComponentSlots;
         // std::vector<HBehaviour> mBehaviours;
 
         //////////////////////////////////////////////////////////////////
@@ -166,20 +207,26 @@ namespace Mix {
         /**
          * \brief Find the child object with the specified name
          * \param _name The name of the child to find
-         * \param _recursive Search the whole hierarchy using DFS
-         * \return First found GameObject or empty if none foune
+         * \param _recursive Search the whole hierarchy instead of direct children only
+         * \return First found GameObject in child order, depth first, or empty if none foune
+         * \note  A recursive search walks the hierarchy, or filters the name index of the Scene instead
+         *        when fewer GameObjects have that name than the hierarchy holds.
          */
         HGameObject findChild(const std::string& _name, bool _recursive = true);
 
         /**
          * \brief Find all child objects with the specified name
          * \param _name The name of the children to find
-         * \param _recursive Search the whole hierarchy using DFS
-         * \return All found GameObject or empty if none foune
+         * \param _recursive Search the whole hierarchy instead of direct children only
+         * \return All found GameObject in child order, depth first, or empty if none foune
          */
         std::vector<HGameObject> findChildren(const std::string& _name, bool _recursive = true);
 
-        /** @brief Activates/Deactivates the GameObject, depending on the given true or false value. */
+        /**
+         * @brief Activates/Deactivates the GameObject, depending on the given true or false value.
+         * @note  activeInHierarchy() of the subtree changes right away. Its Behaviours and Renderers are
+         *        notified in one batch before the next update phase or before rendering.
+         */
         void setActive(bool _active);
 
         auto getAllChildren() const noexcept {
@@ -197,9 +244,15 @@ namespace Mix {
         /** \brief Get the Tag of this GameObject. */
         const auto& getTag() const noexcept { return mTag; }
 
+        /** \brief Set the Tag of this GameObject, the tag index of its Scene is updated. */
+        void setTag(const Tag& _tag);
+
         /** \brief Get the Layer this GameObject belongs to. */
         const auto& getLayer() const noexcept { return mLayer; }
 
+        /** \brief Move this GameObject to another Layer, the layer index of its Scene is updated. */
+        void setLayer(LayerIndex _layer);
+
         /** \note Static-ness should be defined in ctor. */
         bool isStatic() const noexcept { return mFlags.isSet(GameObjectFlags::IsStatic); }
 
@@ -218,6 +271,18 @@ namespace Mix {
 
         void setScene(const std::shared_ptr<Scene>& _scene);
 
+        /** \brief Check whether this GameObject is a descendant of _ancestor. */
+        bool isDescendantOf(const GameObject* _ancestor) const;
+
+        /** \brief Append the descendants named _name to _results in child order, see findChild(). */
+        void findDescendants(const std::string& _name, bool _firstOnly, std::vector<HGameObject>& _results) const;
+
+        /** \brief Child indices leading from _ancestor down to this GameObject, compares in child order. */
+        std::vector<uint32_t> childPath(const GameObject* _ancestor) const;
+
+        /** \brief Recompute activeInHierarchy() of this GameObject and of the descendants it affects. */
+        void updateActiveInHierarchy();
+
         std::shared_ptr<Scene> mScene;
         HGameObject mParent;
         std::vector<HGameObject> mChildren;
@@ -225,11 +290,22 @@ namespace Mix {
         bool mActiveSelf = true;
         bool mActiveInHierarchy = true;
 
+        /** \brief The activeInHierarchy() state the Components were last notified of. */
+        bool mActiveNotified = true;
+
+        /** \brief Set while this GameObject waits in the activation changes of mScene. */
+        bool mActivationQueued = false;
+
         HTransform mTransform;
 
         Tag mTag;
         LayerIndex mLayer;
 
+        /** \brief Positions inside the name, tag and layer index buckets of mScene. */
+        uint32_t mNameIndexPosition = ~0u;
+        uint32_t mTagIndexPosition = ~0u;
+        uint32_t mLayerIndexPosition = ~0u;
+
         /** @brief Insert _ptr into a shortlisted set of Behaviour if it points to what derived from Behaviour. */
         // template<typename _Ty>
         // std::enable_if_t<std::is_base_of_v<Behaviour, _Ty>> addBehaviour(_Ty* _ptr) { mBehaviours.insert(_ptr); }
@@ -282,7 +358,10 @@ namespace Mix {
         // if type _Ty isn't derived from Component
         static_assert(std::is_base_of_v<Component, _Ty>, "A component must be derived from class Component");
 
-        std::shared_ptr<_Ty> component = std::shared_ptr<_Ty>(new _Ty(std::forward<_Args>(_args)...));
+        // Components of the same type are stored contiguously, see ComponentPool
+        std::shared_ptr<_Ty> component = ComponentPool<_Ty>::Get().create([&](void* _memory) {
+            return new(_memory) _Ty(std::forward<_Args>(_args)...);
+        });
 
         HComponent componentHandle = static_scene_object_cast<Component>(SceneObjectManager::Get()->registerObject(component));
 
@@ -303,24 +382,34 @@ namespace Mix {
 
         std::vector<SceneObjectHandle<_Ty>> results;
 
-        for (auto comp : mComponents) {
-            if (comp->getType().isSameType(_Ty::GetType()) || comp->getType().isDerivedFrom(_Ty::GetType()))
-                results.push_back(static_scene_object_cast<_Ty>(comp));
-        }
+        forEachComponent<_Ty>([&results](_Ty& _comp) {
+            results.push_back(static_scene_object_cast<_Ty>(_comp.getHandle()));
+        });
 
         return results;
     }
 
-    template <typename _Ty>
-    bool GameObject::hasComponent() {
-        static_assert(std::is_base_of_v<Component, _Ty>(), "Specified type is not a Component");
+    template<typename _Ty, typename _Func>
+    void GameObject::forEachComponent(_Func&& _func) {
+        static_assert(std::is_base_of_v<Component, _Ty>, "Specified type is not a Component");
 
-        for (auto comp : mComponents) {
-            if (comp->getType().isDerivedFrom(_Ty::GetType()))
-                return true;
+        const Rtti& type = _Ty::GetType();
+        const int first = firstComponentIndex(type);
+        if (first < 0)
+            return;
+
+        for (size_t i = first; i < mComponents.size(); ++i) {
+            Component& comp = *mComponents[i];
+            if (comp.getType().isSameType(type) || comp.getType().isDerivedFrom(type))
+                _func(static_cast<_Ty&>(comp));
         }
+    }
+
+    template <typename _Ty>
+    bool GameObject::hasComponent() {
+        static_assert(std::is_base_of_v<Component, _Ty>, "Specified type is not a Component");
 
-        return false;
+        return firstComponentIndex(_Ty::GetType()) >= 0;
     }
 
 }
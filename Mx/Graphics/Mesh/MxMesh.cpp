@@ -7,6 +7,7 @@
 #include <numeric>
 
 namespace Mix {
+    MX_IMPLEMENT_RTTI(Mesh, ResourceBase);
 
     void Mesh::setPositions(const std::vector<PositionType>& _vertices) {
         createMeshDataIfNotExist();
@@ -302,7 +303,7 @@ namespace Mix {
             if (indexFormat == IndexFormat::UInt32) {
                 size_t offset = 0;
                 for (auto index : mMeshData->indexSet.value()) {
-                    memcpy(indexData.data(), index.data(), index.size() * indexFormatSizeInByte);
+                    memcpy(indexData.data() + offset, index.data(), index.size() * indexFormatSizeInByte);
                     offset += index.size() * indexFormatSizeInByte;
                 }
             }
@@ -322,9 +323,29 @@ namespace Mix {
         mVertexBuffer = vertexBuffer;
         mIndexBuffer = indexBuffer;
         mIndexFormat = indexFormat;
-        mHasIndex = indexByteSize == 0;
+        mHasIndex = indexByteSize != 0;
         mAttributes = attribute;
         mSubMeshes = mMeshData->subMeshes.value();
+        mBounds = ComputeBounds(reinterpret_cast<const std::byte*>(mMeshData->positions.data()), mMeshData->positions.size(), sizeof(PositionType));
+
+        mSubMeshBounds.clear();
+        if (mMeshData->indexSet.has_value()) {
+            const auto& indexSet = mMeshData->indexSet.value();
+            mSubMeshBounds.reserve(indexSet.size());
+            for (size_t i = 0; i < indexSet.size() && i < mSubMeshes.size(); ++i) {
+                const uint32_t baseVertex = mSubMeshes[i].baseVertex;
+                AABB bounds = mBounds;
+                if (!indexSet[i].empty()) {
+                    const auto& first = mMeshData->positions[indexSet[i].front() + baseVertex];
+                    bounds = AABB(first, first);
+                    for (auto index : indexSet[i]) {
+                        const auto& position = mMeshData->positions[index + baseVertex];
+                        bounds.merge(AABB(position, position));
+                    }
+                }
+                mSubMeshBounds.push_back(bounds);
+            }
+        }
         mVertexDeclaration = std::make_shared<VertexDeclaration>(mAttributes);
 
         if (_markNoLongerReadable) {
@@ -353,12 +374,15 @@ namespace Mix {
         if (SendToGPU(_vertexData, _indexData, vertexBuffer, indexBuffer)) {
             std::shared_ptr<Mesh> result = std::make_shared<Mesh>();
             result->mAttributes = _attributeFlags;
-            result->mHasIndex = indexBuffer == nullptr;
+            result->mHasIndex = indexBuffer != nullptr;
             result->mSubMeshes = _subMeshes;
             result->mVertexBuffer = vertexBuffer;
             result->mIndexBuffer = indexBuffer;
             result->mVertexDeclaration = std::make_shared<VertexDeclaration>(result->mAttributes);
 
+            const uint32_t stride = result->mVertexDeclaration->getSizeOfStream(0);
+            result->mBounds = ComputeBounds(_vertexData.data(), _vertexData.size() / stride, stride);
+
             return result;
         }
 
@@ -374,12 +398,15 @@ namespace Mix {
         if (SendToGPU(_vertexData, nullptr, vertexBuffer, indexBuffer)) {
             std::shared_ptr<Mesh> result = std::make_shared<Mesh>();
             result->mAttributes = _attributeFlags;
-            result->mHasIndex = indexBuffer == nullptr;
+            result->mHasIndex = indexBuffer != nullptr;
             result->mSubMeshes = _subMeshes;
             result->mVertexBuffer = vertexBuffer;
             result->mIndexBuffer = nullptr;
             result->mVertexDeclaration = std::make_shared<VertexDeclaration>(result->mAttributes);
 
+            const uint32_t stride = result->mVertexDeclaration->getSizeOfStream(0);
+            result->mBounds = ComputeBounds(_vertexData.data(), _vertexData.size() / stride, stride);
+
             return result;
         }
 
@@ -398,6 +425,21 @@ namespace Mix {
             mMeshData = std::make_shared<MeshData>();
     }
 
+    AABB Mesh::ComputeBounds(const std::byte* _positions, size_t _count, size_t _stride) {
+        if (_count == 0)
+            return AABB(Vector3f::Zero, Vector3f::Zero);
+
+        // Positions are always the first attribute of a vertex
+        PositionType position;
+        memcpy(&position, _positions, sizeof(PositionType));
+        AABB bounds(position, position);
+        for (size_t i = 1; i < _count; ++i) {
+            memcpy(&position, _positions + i * _stride, sizeof(PositionType));
+            bounds.merge(AABB(position, position));
+        }
+        return bounds;
+    }
+
     bool Mesh::SendToGPU(ArrayProxy<const std::byte, vk::DeviceSize> _vertexData,
                          ArrayProxy<const std::byte, vk::DeviceSize> _indexData,
                          std::shared_ptr<Vulkan::Buffer>& _outVertexBuffer,
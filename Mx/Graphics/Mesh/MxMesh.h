@@ -7,6 +7,7 @@
 #include "../../Resource/MxResourceBase.h"
 #include "../../Math/MxVector.h"
 #include "../../Math/MxColor.h"
+#include "../../Math/MxAABB.h"
 #include "../../Utils/MxArrayProxy.h"
 #include "../../Utils/MxFlags.h"
 #include "../../Definitions/MxCommonEnum.h"
@@ -18,6 +19,7 @@ namespace Mix {
 	}
 
 	class Mesh :public ResourceBase {
+		MX_DECLARE_RTTI;
 		friend class Vulkan::ShaderBase;
 	public:
 
@@ -83,6 +85,16 @@ namespace Mix {
 
 		MeshTopology getTopology(uint32_t _submesh) const;
 
+		const SubMesh& getSubMesh(uint32_t _submesh) const { return mSubMeshes[_submesh]; }
+
+		/** \brief Local space bounds of the vertices, computed when the vertex data is sent to the GPU. */
+		const AABB& getBounds() const { return mBounds; }
+
+		/** \brief Local space bounds of the vertices referenced by a submesh, those of the whole Mesh if unknown. */
+		const AABB& getSubMeshBounds(uint32_t _submesh) const {
+			return _submesh < mSubMeshBounds.size() ? mSubMeshBounds[_submesh] : mBounds;
+		}
+
 		void clear();
 
 		bool hasAttributes(Flags<VertexAttribute> _attributesMask) const { return mAttributes.isAllSet(_attributesMask); }
@@ -136,11 +148,16 @@ namespace Mix {
 		std::shared_ptr<Vulkan::Buffer> mIndexBuffer;
 		std::shared_ptr<MeshData> mMeshData;
 		std::vector<SubMesh> mSubMeshes;
+		AABB mBounds;
+		std::vector<AABB> mSubMeshBounds;
 
 		// ---------- Private method ----------
 
 		void createMeshDataIfNotExist();
 
+		/** \brief Bounds of _count positions placed _stride bytes apart. */
+		static AABB ComputeBounds(const std::byte* _positions, size_t _count, size_t _stride);
+
 		// ---------- static method ----------
 
 		static bool SendToGPU(ArrayProxy<const std::byte, vk::DeviceSize> _vertexData,
@@ -0,0 +1,98 @@
+#include "MxCullingBounds.h"
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MX_CULLING_SSE_
+#include <xmmintrin.h>
+#endif
+
+namespace Mix {
+    void CullingBounds::clear() {
+        mCenterX.clear();
+        mCenterY.clear();
+        mCenterZ.clear();
+        mExtentX.clear();
+        mExtentY.clear();
+        mExtentZ.clear();
+    }
+
+    void CullingBounds::reserve(uint32_t _count) {
+        mCenterX.reserve(_count);
+        mCenterY.reserve(_count);
+        mCenterZ.reserve(_count);
+        mExtentX.reserve(_count);
+        mExtentY.reserve(_count);
+        mExtentZ.reserve(_count);
+    }
+
+    void CullingBounds::push(const AABB& _box) {
+        const Vector3f center = _box.getCenter();
+        const Vector3f extent = _box.getExtent() * 0.5f;
+        mCenterX.push_back(center.x);
+        mCenterY.push_back(center.y);
+        mCenterZ.push_back(center.z);
+        mExtentX.push_back(extent.x);
+        mExtentY.push_back(extent.y);
+        mExtentZ.push_back(extent.z);
+    }
+
+    void CullingBounds::test(const Frustum& _frustum, std::vector<uint8_t>& _visible) const {
+        const uint32_t count = size();
+        _visible.resize(count);
+
+        // A box is outside a plane when its center is further behind it than its projected radius
+        struct PlaneData {
+            float nx, ny, nz, d, ax, ay, az;
+        } planes[Frustum::SideCount];
+
+        for (uint32_t p = 0; p < Frustum::SideCount; ++p) {
+            const Plane& plane = _frustum.getPlane(static_cast<Frustum::Side>(p));
+            planes[p] = { plane.normal.x, plane.normal.y, plane.normal.z, plane.distance,
+                std::abs(plane.normal.x), std::abs(plane.normal.y), std::abs(plane.normal.z) };
+        }
+
+        uint32_t i = 0;
+
+#ifdef MX_CULLING_SSE_
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4) {
+            const __m128 cx = _mm_loadu_ps(mCenterX.data() + i);
+            const __m128 cy = _mm_loadu_ps(mCenterY.data() + i);
+            const __m128 cz = _mm_loadu_ps(mCenterZ.data() + i);
+            const __m128 ex = _mm_loadu_ps(mExtentX.data() + i);
+            const __m128 ey = _mm_loadu_ps(mExtentY.data() + i);
+            const __m128 ez = _mm_loadu_ps(mExtentZ.data() + i);
+
+            __m128 outside = zero;
+            for (auto& plane : planes) {
+                __m128 distance = _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(plane.nx)), _mm_set1_ps(plane.d));
+                distance = _mm_add_ps(distance, _mm_mul_ps(cy, _mm_set1_ps(plane.ny)));
+                distance = _mm_add_ps(distance, _mm_mul_ps(cz, _mm_set1_ps(plane.nz)));
+
+                __m128 radius = _mm_mul_ps(ex, _mm_set1_ps(plane.ax));
+                radius = _mm_add_ps(radius, _mm_mul_ps(ey, _mm_set1_ps(plane.ay)));
+                radius = _mm_add_ps(radius, _mm_mul_ps(ez, _mm_set1_ps(plane.az)));
+
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+            }
+
+            const int mask = _mm_movemask_ps(outside);
+            for (uint32_t k = 0; k < 4; ++k)
+                _visible[i + k] = static_cast<uint8_t>(((mask >> k) & 1) ^ 1);
+        }
+#endif
+
+        for (; i < count; ++i) {
+            uint8_t visible = 1;
+            for (auto& plane : planes) {
+                const float distance = mCenterX[i] * plane.nx + mCenterY[i] * plane.ny + mCenterZ[i] * plane.nz + plane.d;
+                const float radius = mExtentX[i] * plane.ax + mExtentY[i] * plane.ay + mExtentZ[i] * plane.az;
+                if (distance + radius < 0.0f) {
+                    visible = 0;
+                    break;
+                }
+            }
+            _visible[i] = visible;
+        }
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+#ifndef MX_CULLING_BOUNDS_H_
+#define MX_CULLING_BOUNDS_H_
+
+#include "../Math/MxFrustum.h"
+#include <vector>
+
+namespace Mix {
+    /**
+     * \brief World space boxes stored as separate center and half extent arrays, so that they are tested
+     *        against a Frustum four at a time with SSE. Builds without SSE fall back to one box at a time.
+     */
+    class CullingBounds {
+    public:
+        void clear();
+
+        void reserve(uint32_t _count);
+
+        void push(const AABB& _box);
+
+        uint32_t size() const { return static_cast<uint32_t>(mCenterX.size()); }
+
+        /** \brief Resize _visible to size(), set _visible[i] to 1 if box i intersects _frustum and to 0 if not. */
+        void test(const Frustum& _frustum, std::vector<uint8_t>& _visible) const;
+
+    private:
+        std::vector<float> mCenterX;
+        std::vector<float> mCenterY;
+        std::vector<float> mCenterZ;
+        std::vector<float> mExtentX;
+        std::vector<float> mExtentY;
+        std::vector<float> mExtentZ;
+    };
+}
+
+#endif
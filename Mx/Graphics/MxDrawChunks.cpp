@@ -0,0 +1,39 @@
+#include "MxDrawChunks.h"
+#include <algorithm>
+
+namespace Mix {
+    void SplitDrawChunks(const RenderQueueElement* _elements,
+                         const uint32_t _count,
+                         const uint32_t _maxChunks,
+                         const uint32_t _minChunkSize,
+                         std::vector<DrawChunk>& _chunks) {
+        if (_count == 0 || _maxChunks == 0)
+            return;
+
+        // Every chunk but the last one holds at least chunkSize elements, so there are at most _maxChunks
+        const uint32_t chunkSize = std::max((_count + _maxChunks - 1) / _maxChunks, std::max(_minChunkSize, 1u));
+
+        uint32_t first = 0;
+        while (first < _count) {
+            uint32_t last = std::min(first + chunkSize, _count);
+            while (last < _count && IsSameInstance(*_elements[last - 1].element, *_elements[last].element))
+                ++last;
+
+            _chunks.push_back(DrawChunk{ first, last - first });
+            first = last;
+        }
+    }
+
+    uint32_t SplitDrawQueues(const std::vector<RenderQueueElement>& _opaque,
+                             const std::vector<RenderQueueElement>& _transparent,
+                             const uint32_t _slotCount,
+                             std::vector<DrawChunk>& _chunks) {
+        const uint32_t maxChunks = _slotCount > 1 ? (_slotCount - 1) / 2 : 0;
+
+        _chunks.clear();
+        SplitDrawChunks(_opaque.data(), static_cast<uint32_t>(_opaque.size()), maxChunks, MinDrawChunkSize, _chunks);
+        const uint32_t opaqueChunkCount = static_cast<uint32_t>(_chunks.size());
+        SplitDrawChunks(_transparent.data(), static_cast<uint32_t>(_transparent.size()), maxChunks, MinDrawChunkSize, _chunks);
+        return opaqueChunkCount;
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+#ifndef MX_DRAW_CHUNKS_H_
+#define MX_DRAW_CHUNKS_H_
+
+#include "MxRenderQueue.h"
+#include <vector>
+
+namespace Mix {
+    /** \brief A range of a sorted render queue, recorded into its own secondary command buffer. */
+    struct DrawChunk {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    /** \brief Check if _b can be drawn in the same instanced call as _a. */
+    inline bool IsSameInstance(const RenderElement& _a, const RenderElement& _b) {
+        return _a.mesh == _b.mesh && _a.submesh == _b.submesh && _a.material == _b.material &&
+            _a.transform && _b.transform && _a.submeshCount == 1 && _b.submeshCount == 1;
+    }
+
+    /** \brief Fewer elements are not worth a secondary command buffer of their own. */
+    constexpr uint32_t MinDrawChunkSize = 64;
+
+    /**
+     * \brief Split _count sorted elements into at most _maxChunks chunks of at least _minChunkSize elements,
+     *        except for the last one, and append them to _chunks in order.
+     *
+     *        A chunk boundary never falls inside a run of instanced copies, so recording the chunks one after
+     *        the other draws the same as recording the whole range at once.
+     */
+    void SplitDrawChunks(const RenderQueueElement* _elements,
+                         uint32_t _count,
+                         uint32_t _maxChunks,
+                         uint32_t _minChunkSize,
+                         std::vector<DrawChunk>& _chunks);
+
+    /**
+     * \brief Replace _chunks with the chunks of the opaque queue followed by those of the transparent queue,
+     *        for _slotCount command buffer slots. The last slot is kept for the UI, each queue gets at most
+     *        half of the others. Chunk i is recorded into slot i, so executing the slots of _chunks in order
+     *        draws everything in sorted order.
+     * \return The amount of opaque chunks.
+     */
+    uint32_t SplitDrawQueues(const std::vector<RenderQueueElement>& _opaque,
+                             const std::vector<RenderQueueElement>& _transparent,
+                             uint32_t _slotCount,
+                             std::vector<DrawChunk>& _chunks);
+
+    /**
+     * \brief Record _count sorted elements into _context.
+     *
+     *        _getShader(shaderId) returns the Shader drawing an element. Consecutive copies of the same
+     *        geometry and Material are drawn with Shader::renderInstanced(), _run is scratch storage.
+     *        Only touches _context and _run, chunks are recorded on several threads at once.
+     */
+    template<typename _Context, typename _GetShader>
+    void RecordDrawChunk(const RenderQueueElement* _elements,
+                         uint32_t _count,
+                         _Context& _context,
+                         _GetShader&& _getShader,
+                         std::vector<RenderElement*>& _run) {
+        if (_count == 0)
+            return;
+
+        uint32_t lastId = _elements[0].shaderId;
+        auto shader = &_getShader(lastId);
+        shader->beginRender(_context);
+
+        uint32_t i = 0;
+        while (i < _count) {
+            const RenderQueueElement& elem = _elements[i];
+            if (lastId != elem.shaderId) {
+                shader->endRender(_context);
+                lastId = elem.shaderId;
+                shader = &_getShader(lastId);
+                shader->beginRender(_context);
+            }
+
+            // The sort key keeps copies of the same geometry and Material next to each other
+            _run.clear();
+            _run.push_back(elem.element);
+            while (++i < _count && IsSameInstance(*elem.element, *_elements[i].element))
+                _run.push_back(_elements[i].element);
+
+            if (_run.size() == 1)
+                shader->render(_context, *elem.element);
+            else
+                shader->renderInstanced(_context, _run.data(), static_cast<uint32_t>(_run.size()));
+        }
+        shader->endRender(_context);
+    }
+}
+
+#endif
@@ -6,24 +6,31 @@
 #include <queue>
 #include "../Scene/MxSceneManager.h"
 #include "MxRenderQueue.h"
+#include "MxStaticBatch.h"
+#include "MxCullingBounds.h"
+#include "../Math/MxFrustum.h"
 #include "../Component/Renderer/MxRenderer.h"
 #include "../Component/MeshFilter/MxMeshFilter.h"
 #include "../Component/Camera/MxCamera.h"
 #include "../Vulkan/Shader/MxVkPBRShader.h"
 #include "../Vulkan/Shader/MxVkUIRenderer.h"
+#include "../Vulkan/CommandBuffer/MxVkSecondaryCommandBuffers.h"
+#include "../Vulkan/Swapchain/MxVkSwapchain.h"
+#include "../Thread/MxThreadPool.h"
 
 
 namespace Mix {
-
     Graphics* Graphics::Get() {
         return MixEngine::Instance().getModule<Graphics>();
     }
 
     Graphics::~Graphics() {
         mVulkan->waitDeviceIdle();
+        mBatchElements.clear();
         mShaderNameMap.clear();
         mShaders.clear();
         mUiRenderer.reset();
+        mSecondaryCommandBuffers.reset();
         mVulkan.reset();
     }
 
@@ -47,87 +54,165 @@ namespace Mix {
         Camera& camera = *renderInfo.camera;
         Vector3f cameraPos = renderInfo.camera->transform()->getPosition();
 
-        std::vector<RenderElement> renderElements;
+        mOpaqueQueue.clear();
+        mTransparentQueue.clear();
 
-        RenderQueue transparentQueue(RenderQueue::SortType_BackToFront);
-        RenderQueue opaqueQueue(RenderQueue::SortType_FrontToBack);
+        // Cull whole Renderers first, then the submeshes of the visible ones
+        const Frustum frustum(camera.getProjMat() * camera.getViewMat());
+        mCullCandidates.clear();
+        mRendererBounds.clear();
+        mRendererBounds.reserve(renderInfo.rendererCount);
 
-        for (auto& renderer : renderInfo.renderers) {
-            auto mesh = renderer->getGameObject()->getComponent<MeshFilter>()->getMesh();
-            if (mesh) {
-                auto& materials = renderer->getMaterials();
+        for (uint32_t r = 0; r < renderInfo.rendererCount; ++r) {
+            Renderer* renderer = renderInfo.renderers[r];
+            auto& elements = renderer->getRenderElements();
+            if (renderer->isStaticBatched() || elements.empty())
+                continue;
 
-                uint32_t count = std::min(mesh->subMeshCount(), static_cast<uint32_t>(materials.size()));
-                for (uint32_t i = 0; i < count; ++i) {
-                    RenderElement re;
-                    re.transform = renderer->transform();
-                    re.material = materials[i];
-                    re.mesh = mesh;
-                    re.submesh = i;
+            const RenderElement& first = elements.front();
+            mCullCandidates.push_back(renderer);
+            mRendererBounds.push(first.mesh->getBounds().transformed(first.transform->cachedLocalToWorldMatrix()));
+        }
+        mRendererBounds.test(frustum, mVisible);
+
+        for (size_t c = 0; c < mCullCandidates.size(); ++c) {
+            if (!mVisible[c])
+                continue;
+
+            auto& elements = mCullCandidates[c]->mRenderElements;
+            const Mesh& mesh = *elements.front().mesh;
+            const Matrix4& localToWorld = elements.front().transform->cachedLocalToWorldMatrix();
+
+            const bool testSubMeshes = elements.size() > 1;
+            if (testSubMeshes) {
+                mSubMeshBounds.clear();
+                for (auto& element : elements)
+                    mSubMeshBounds.push(mesh.getSubMeshBounds(element.submesh).transformed(localToWorld));
+                mSubMeshBounds.test(frustum, mSubMeshVisible);
+            }
 
-                    renderElements.push_back(re);
-                }
+            // The elements are owned by the Renderer, the queues keep pointers to them
+            const float distance = (localToWorld.getTranslation() - cameraPos).length();
+            for (size_t i = 0; i < elements.size(); ++i) {
+                if (!testSubMeshes || mSubMeshVisible[i])
+                    queueElement(elements[i], distance);
             }
         }
 
-        for (auto& element : renderElements) {
-            float dist = (element.transform->getPosition() - cameraPos).length();
-
-            switch (element.material->getRenderType()) {
-            case RenderType::Transparent: transparentQueue.push(&element, dist); break;
-            default:
-            case RenderType::Opaque: opaqueQueue.push(&element, dist); break;
+        // Each run of visible pieces is one element, drawn with the identity transform
+        mBatchElements.clear();
+        mBatchDistances.clear();
+        for (uint32_t b = 0; b < renderInfo.staticBatchCount; ++b) {
+            const StaticBatch& batch = renderInfo.staticBatches[b];
+            if (!frustum.intersects(batch.getBounds()))
+                continue;
+
+            batch.getPieceBounds().test(frustum, mVisible);
+            mBatchRuns.clear();
+            batch.getVisibleRuns(renderInfo.rendererCount, mVisible, mBatchRuns);
+
+            for (auto& [first, count] : mBatchRuns) {
+                RenderElement re;
+                re.mesh = batch.getMesh();
+                re.material = batch.getMaterial();
+                re.submesh = first;
+                re.submeshCount = count;
+
+                mBatchElements.push_back(std::move(re));
+                mBatchDistances.push_back((batch.getPieces()[first].bounds.getCenter() - cameraPos).length());
             }
         }
 
-        transparentQueue.sort();
-        opaqueQueue.sort();
+        // Only queued once complete, growing the array moves the elements
+        for (size_t e = 0; e < mBatchElements.size(); ++e)
+            queueElement(mBatchElements[e], mBatchDistances[e]);
 
-        auto& transparentElements = transparentQueue.getSortedElements();
-        auto& opaqueElements = opaqueQueue.getSortedElements();
+        mTransparentQueue.sort();
+        mOpaqueQueue.sort();
+
+        auto& transparentElements = mTransparentQueue.getSortedElements();
+        auto& opaqueElements = mOpaqueQueue.getSortedElements();
 
         mVulkan->beginRender();
 
-        // Render all opaque elements
-        if (!opaqueElements.empty()) {
-            uint32_t lastId = opaqueElements.front().shaderId;
+        // Everything the recording threads only read is uploaded beforehand
+        for (auto& shader : mShaders)
+            shader.second->beginFrame(camera);
+        prepareMaterials(opaqueElements);
+        prepareMaterials(transparentElements);
 
-            mShaders[lastId]->beginRender(camera);
-            for (auto& elem : opaqueElements) {
-                if (lastId != elem.shaderId) {
-                    mShaders[lastId]->endRender();
+        mExecutedSlots.clear();
+        recordQueues(opaqueElements, transparentElements);
 
-                    mShaders[elem.shaderId]->beginRender(camera);
-                }
-                mShaders[elem.shaderId]->render(*elem.element);
-            }
-            mShaders[lastId]->endRender();
+        // UI
+        GUI::UIRenderData renderData;
+        bool renderUi = GUI::Get()->getRenderData(renderData);
+        if (renderUi) {
+            const uint32_t frame = mVulkan->getCurrFrame();
+            const uint32_t uiSlot = mSecondaryCommandBuffers->slotCount() - 1;
+            Vulkan::CommandStateCache cmd(mSecondaryCommandBuffers->begin(frame, uiSlot, mVulkan->getRenderPass()->get(), 0, mVulkan->getCurrFrameBuffer().get()));
+            mUiRenderer->render(cmd, renderData);
+            mSecondaryCommandBuffers->end(frame, uiSlot);
+            mExecutedSlots.push_back(uiSlot);
+            mCommandStats += cmd.getStats();
         }
 
-        // Render all transparent elements
-        if (!transparentElements.empty()) {
-            uint32_t lastId = transparentElements.front().shaderId;
+        mSecondaryCommandBuffers->execute(mVulkan->getCurrDrawCmd().get(), mVulkan->getCurrFrame(), mExecutedSlots);
 
-            mShaders[lastId]->beginRender(camera);
-            for (auto& elem : transparentElements) {
-                if (lastId != elem.shaderId) {
-                    mShaders[lastId]->endRender();
+        mVulkan->endRender();
+    }
 
-                    mShaders[elem.shaderId]->beginRender(camera);
-                }
-                mShaders[elem.shaderId]->render(*elem.element);
-            }
-            mShaders[lastId]->endRender();
+    void Graphics::prepareMaterials(const std::vector<RenderQueueElement>& _elements) {
+        const Material* lastMaterial = nullptr;
+        for (auto& elem : _elements) {
+            // Elements sharing a Material are mostly next to each other
+            Material* material = elem.element->material.get();
+            if (material == lastMaterial)
+                continue;
+
+            mShaders.find(elem.shaderId)->second->prepareMaterial(*material);
+            lastMaterial = material;
         }
+    }
 
+    void Graphics::recordQueues(const std::vector<RenderQueueElement>& _opaque, const std::vector<RenderQueueElement>& _transparent) {
+        // Each queue gets up to one chunk per thread, the UI keeps the last slot
+        const uint32_t opaqueChunkCount = SplitDrawQueues(_opaque, _transparent, mSecondaryCommandBuffers->slotCount(), mDrawChunks);
+        const uint32_t chunkCount = static_cast<uint32_t>(mDrawChunks.size());
 
-        // UI
-        GUI::UIRenderData renderData;
-        bool renderUi = GUI::Get()->getRenderData(renderData);
-        if (renderUi)
-            mUiRenderer->render(renderData);
+        const uint32_t frame = mVulkan->getCurrFrame();
+        const vk::RenderPass& renderPass = mVulkan->getRenderPass()->get();
+        const vk::Framebuffer& framebuffer = mVulkan->getCurrFrameBuffer().get();
 
-        mVulkan->endRender();
+        // Shaders are only looked up, mShaders is not modified while recording
+        auto getShader = [this](uint32_t _id) -> Shader& { return *mShaders.find(_id)->second; };
+
+        ThreadPool::Get()->parallelFor(0, chunkCount, 1, [&](uint32_t _begin, uint32_t _end) {
+            for (uint32_t c = _begin; c < _end; ++c) {
+                const DrawChunk& chunk = mDrawChunks[c];
+                const RenderQueueElement* elements = c < opaqueChunkCount ? _opaque.data() : _transparent.data();
+
+                Vulkan::DrawContext context(mSecondaryCommandBuffers->begin(frame, c, renderPass, 0, framebuffer), frame);
+                RecordDrawChunk(elements + chunk.first, chunk.count, context, getShader, mInstanceRuns[c]);
+                mSecondaryCommandBuffers->end(frame, c);
+                mSlotStats[c] = context.cmd.getStats();
+            }
+        });
+
+        // Executed in chunk order, which is the sorted order
+        mCommandStats = Vulkan::CommandStats();
+        for (uint32_t c = 0; c < chunkCount; ++c) {
+            mExecutedSlots.push_back(c);
+            mCommandStats += mSlotStats[c];
+        }
+    }
+
+    void Graphics::queueElement(RenderElement& _element, float _distance) {
+        switch (_element.material->getRenderType()) {
+        case RenderType::Transparent: mTransparentQueue.push(&_element, _distance); break;
+        default:
+        case RenderType::Opaque: mOpaqueQueue.push(&_element, _distance); break;
+        }
     }
 
     std::shared_ptr<Shader> Graphics::findShader(const std::string& _name) {
@@ -170,6 +255,15 @@ namespace Mix {
         addShader("PBR", pbr);
 
         mUiRenderer = std::make_shared<Vulkan::UIRenderer>(mVulkan.get());
+
+        // One chunk per thread and queue, the calling thread records too
+        const uint32_t recordingThreads = ThreadPool::Get()->threadCount() + 1;
+        const uint32_t slotCount = recordingThreads * 2 + 1;
+        mSecondaryCommandBuffers = std::make_unique<Vulkan::SecondaryCommandBuffers>(mVulkan->getLogicalDevice(),
+                                                                                    mVulkan->getSwapchain()->imageCount(),
+                                                                                    slotCount);
+        mInstanceRuns.resize(slotCount);
+        mSlotStats.resize(slotCount);
     }
 
     void Graphics::addShader(const std::string _name, const std::shared_ptr<Vulkan::ShaderBase>& _shader) {
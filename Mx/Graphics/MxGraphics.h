@@ -5,14 +5,21 @@
 #include "../Engine/MxModuleBase.h"
 #include "MxShader.h"
 #include "../Vulkan/MxVulkan.h"
+#include "../Vulkan/CommandBuffer/MxVkCommandStateCache.h"
+#include "MxRenderQueue.h"
+#include "MxCullingBounds.h"
+#include "MxDrawChunks.h"
 
 namespace Mix {
     class Window;
+    class Renderer;
+    class Camera;
     struct SceneRenderInfo;
 
     namespace Vulkan {
         class VulkanAPI;
         class UIRenderer;
+        class SecondaryCommandBuffers;
     }
 
     class Graphics :public ModuleBase {
@@ -33,6 +40,9 @@ namespace Mix {
 
         std::shared_ptr<Shader> findShader(const std::string& _name);
 
+        /** \brief State commands recorded and dropped as redundant during the last frame. */
+        const Vulkan::CommandStats& getCommandStats() const { return mCommandStats; }
+
     private:
         void initRenderAPI(Window* _window);
 
@@ -40,12 +50,50 @@ namespace Mix {
 
         void addShader(const std::string _name, const std::shared_ptr<Vulkan::ShaderBase>& _shader);
 
+        /** \brief Apply the pending changes of the Materials of _elements before they are recorded. */
+        void prepareMaterials(const std::vector<RenderQueueElement>& _elements);
+
+        /**
+         * \brief Record both sorted queues into secondary command buffers, one chunk per slot, in parallel.
+         *        The recorded slots are appended to mExecutedSlots in draw order.
+         */
+        void recordQueues(const std::vector<RenderQueueElement>& _opaque, const std::vector<RenderQueueElement>& _transparent);
+
+        /** \brief Push _element to the queue matching the render type of its Material. */
+        void queueElement(RenderElement& _element, float _distance);
+
         std::unique_ptr<Vulkan::VulkanAPI> mVulkan;
 
         std::unordered_map<uint32_t, std::shared_ptr<Shader>> mShaders;
         std::unordered_map<std::string, uint32_t> mShaderNameMap;
 
         std::shared_ptr<Vulkan::UIRenderer> mUiRenderer;
+
+        /** \brief Draw chunks split for each recording thread, the last slot holds the UI. */
+        std::unique_ptr<Vulkan::SecondaryCommandBuffers> mSecondaryCommandBuffers;
+
+        RenderQueue mOpaqueQueue{ RenderQueue::SortType_FrontToBack };
+        RenderQueue mTransparentQueue{ RenderQueue::SortType_BackToFront };
+
+        // Per frame scratch, kept to reuse the allocations
+        std::vector<Renderer*> mCullCandidates;
+        CullingBounds mRendererBounds;
+        CullingBounds mSubMeshBounds;
+        std::vector<uint8_t> mVisible;
+        std::vector<uint8_t> mSubMeshVisible;
+        std::vector<std::pair<uint32_t, uint32_t>> mBatchRuns;
+
+        /** \brief One element per run of visible StaticBatch pieces, rebuilt every frame. */
+        std::vector<RenderElement> mBatchElements;
+        std::vector<float> mBatchDistances;
+
+        std::vector<DrawChunk> mDrawChunks;
+        std::vector<uint32_t> mExecutedSlots;
+
+        /** \brief Instance run scratch of each slot, slots are recorded on different threads. */
+        std::vector<std::vector<RenderElement*>> mInstanceRuns;
+        std::vector<Vulkan::CommandStats> mSlotStats;
+        Vulkan::CommandStats mCommandStats;
     };
 }
 
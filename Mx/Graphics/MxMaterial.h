@@ -47,7 +47,7 @@ namespace Mix {
 
         const std::unordered_set<std::string>& _getChangedList() const { return mChangedList; }
 
-        std::shared_ptr<Shader> getShader() const { return mShader; }
+        const std::shared_ptr<Shader>& getShader() const { return mShader; }
 
     private:
 
@@ -12,6 +12,7 @@ namespace Mix {
     class Material;
     class Renderer;
     class Camera;
+    class StaticBatch;
 
 
     /**
@@ -20,15 +21,25 @@ namespace Mix {
     struct SceneRenderInfo {
         Camera* camera = nullptr;
 
-        std::vector<Renderer*> renderers;
+        /** \brief Enabled Renderers on active GameObjects. Owned by the Scene, valid until the Scene changes. */
+        Renderer* const* renderers = nullptr;
+        uint32_t rendererCount = 0;
+
+        /** \brief Merged static geometry, the Renderers it was built from are skipped. */
+        const StaticBatch* staticBatches = nullptr;
+        uint32_t staticBatchCount = 0;
     };
 
 
     struct RenderElement {
+        /** \brief Null for geometry already in world space, e.g. a StaticBatch. */
         HTransform transform;
         std::shared_ptr<Mesh> mesh;
         std::shared_ptr<Material> material;
         uint32_t submesh;
+
+        /** \brief Submeshes from submesh on drawn as one range, they must be contiguous in the index buffer. */
+        uint32_t submeshCount = 1;
     };
 }
 
@@ -1,5 +1,7 @@
 #include "MxRenderQueue.h"
 #include "MxMaterial.h"
+#include "Mesh/MxMesh.h"
+#include <cstring>
 
 namespace Mix {
 
@@ -7,46 +9,91 @@ namespace Mix {
     }
 
     void RenderQueue::push(RenderElement* _element, float _distFromCamera) {
-        SortElement element;
+        RenderQueueElement element;
         element.element = _element;
-        element.disFromCamera = mSortType == SortType_FrontToBack ? _distFromCamera : -_distFromCamera;
         element.shaderId = _element->material->getShader()->getId();
 
-        mSortIndex.push_back(mSortElements.size());
-        mSortElements.push_back(element);
+        const uint64_t key = MakeSortKey(*_element, element.shaderId, _distFromCamera, mSortType);
+        mSortElements.push_back(SortElement{ key, static_cast<uint32_t>(mElements.size()) });
+        mElements.push_back(element);
     }
 
     void RenderQueue::clear() {
+        mElements.clear();
         mSortElements.clear();
-        mSortIndex.clear();
         mSortedElements.clear();
     }
 
     void RenderQueue::sort() {
-        std::sort(mSortIndex.begin(), mSortIndex.end(),
-                  [&](const size_t& _a, const size_t& _b) {
-                      auto& eleA = mSortElements[_a];
-                      auto& eleB = mSortElements[_b];
-
-                      uint8_t h = (eleA.shaderId > eleB.shaderId) << 1 |
-                          (eleA.disFromCamera > eleB.disFromCamera);
-
-                      uint8_t l = (eleA.shaderId < eleB.shaderId) << 1 |
-                          (eleA.disFromCamera < eleB.disFromCamera);
-
-                      return l > h;
-                  }
-        );
-
-        for (auto& idx : mSortIndex) {
-            RenderQueueElement element;
-            element.element = mSortElements[idx].element;
-            element.shaderId = mSortElements[idx].shaderId;
-            mSortedElements.push_back(element);
-        }
+        RadixSort(mSortElements, mSortScratch);
+
+        mSortedElements.resize(mSortElements.size());
+        for (size_t i = 0; i < mSortElements.size(); ++i)
+            mSortedElements[i] = mElements[mSortElements[i].index];
     }
 
     const std::vector<RenderQueueElement>& RenderQueue::getSortedElements() const {
         return mSortedElements;
     }
+
+    uint64_t RenderQueue::MakeSortKey(const RenderElement& _element, uint32_t _shaderId, float _distFromCamera, SortType _type) {
+        // The bits of a non-negative float sort like the float itself
+        const float distance = _distFromCamera > 0.0f ? _distFromCamera : 0.0f;
+        uint32_t depth;
+        std::memcpy(&depth, &distance, sizeof(depth));
+
+        const uint64_t pipeline = static_cast<uint32_t>(_element.mesh->getAttributesFlags()) << 2 |
+            static_cast<uint32_t>(_element.mesh->getTopology(_element.submesh));
+        const uint64_t state = static_cast<uint64_t>(_shaderId & 0xFF) << 24 |
+            (pipeline & 0xFF) << 16 |
+            (_element.material->_getMaterialId() & 0xFFFF);
+
+        if (_type == SortType_FrontToBack) {
+            // The upper half of the float bits keeps the exponent and 7 bits of mantissa, under 1% error
+            const uint64_t mesh = reinterpret_cast<uintptr_t>(_element.mesh.get());
+            const uint64_t geometry = ((mesh >> 4) ^ (mesh >> 20)) + _element.submesh;
+            return state << 32 | (geometry & 0xFFFF) << 16 | depth >> 16;
+        }
+        return static_cast<uint64_t>(~depth) << 32 | state;
+    }
+
+    void RenderQueue::RadixSort(std::vector<SortElement>& _elements, std::vector<SortElement>& _scratch) {
+        constexpr uint32_t PassCount = sizeof(uint64_t);
+        const size_t count = _elements.size();
+        if (count < 2)
+            return;
+        _scratch.resize(count);
+
+        // The counts of every byte are gathered in a single pass over the keys
+        uint32_t histograms[PassCount][256] = {};
+        for (auto& element : _elements) {
+            for (uint32_t pass = 0; pass < PassCount; ++pass)
+                ++histograms[pass][(element.key >> (pass * 8)) & 0xFF];
+        }
+
+        SortElement* src = _elements.data();
+        SortElement* dst = _scratch.data();
+        for (uint32_t pass = 0; pass < PassCount; ++pass) {
+            uint32_t* histogram = histograms[pass];
+            const uint32_t shift = pass * 8;
+
+            // Every key has the same byte, e.g. the shader id in a scene using one shader
+            if (histogram[(src[0].key >> shift) & 0xFF] == count)
+                continue;
+
+            uint32_t offset = 0;
+            for (uint32_t bucket = 0; bucket < 256; ++bucket) {
+                const uint32_t bucketCount = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += bucketCount;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+                dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+            std::swap(src, dst);
+        }
+
+        if (src != _elements.data())
+            _elements.swap(_scratch);
+    }
 }
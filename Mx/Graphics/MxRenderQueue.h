@@ -11,11 +11,20 @@ namespace Mix {
         uint32_t shaderId;
     };
 
+    /**
+     * \brief Elements sorted by a packed 64-bit key, using a radix sort.
+     *
+     *        From the most significant bits, a front to back key holds the shader id (8 bits), the pipeline
+     *        made of the vertex attributes and topology of the mesh (8 bits), the material id (16 bits), a hash
+     *        of the mesh and submesh (16 bits) and the distance to the camera (16 bits). Consecutive elements
+     *        then share as much state as possible, copies of the same geometry end up next to each other to be
+     *        instanced and are drawn nearest first. A back to front key starts with the inverted distance
+     *        (32 bits) instead, blending needs the exact order, and keeps the state fields below it.
+     */
     class RenderQueue {
         struct SortElement {
-            RenderElement* element;
-            uint32_t shaderId;
-            float disFromCamera;
+            uint64_t key;
+            uint32_t index;
         };
 
     public:
@@ -34,9 +43,17 @@ namespace Mix {
 
         const std::vector<RenderQueueElement>& getSortedElements() const;
 
+        /** \brief Build the sort key of _element for a queue of _type. */
+        static uint64_t MakeSortKey(const RenderElement& _element, uint32_t _shaderId, float _distFromCamera, SortType _type);
+
     private:
+        /** \brief Sort _elements by key, _scratch must be as large. The result ends up in _elements. */
+        static void RadixSort(std::vector<SortElement>& _elements, std::vector<SortElement>& _scratch);
+
+        /** \brief Pushed elements, in push order. */
+        std::vector<RenderQueueElement> mElements;
         std::vector<SortElement> mSortElements;
-        std::vector<size_t> mSortIndex; 
+        std::vector<SortElement> mSortScratch;
         std::vector<RenderQueueElement> mSortedElements;
         SortType mSortType;
     };
@@ -62,15 +62,27 @@ namespace Mix {
         mShader->deleteMaterial(_id);
     }
 
-    void Shader::beginRender(const Camera& _camera) {
-        mShader->beginRender(_camera);
+    void Shader::beginFrame(const Camera& _camera) {
+        mShader->beginFrame(_camera);
     }
 
-    void Shader::render(RenderElement& _element) {
-        mShader->render(_element);
+    void Shader::prepareMaterial(Material& _material) {
+        mShader->prepareMaterial(_material);
     }
 
-    void Shader::endRender() {
-        mShader->endRender();
+    void Shader::beginRender(Vulkan::DrawContext& _context) {
+        mShader->beginRender(_context);
+    }
+
+    void Shader::render(Vulkan::DrawContext& _context, RenderElement& _element) {
+        mShader->render(_context, _element);
+    }
+
+    void Shader::renderInstanced(Vulkan::DrawContext& _context, RenderElement* const* _elements, uint32_t _count) {
+        mShader->renderInstanced(_context, _elements, _count);
+    }
+
+    void Shader::endRender(Vulkan::DrawContext& _context) {
+        mShader->endRender(_context);
     }
 }
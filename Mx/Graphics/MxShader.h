@@ -19,6 +19,7 @@ namespace Mix {
 
     namespace Vulkan {
         class ShaderBase;
+        struct DrawContext;
     }
 
     enum class MaterialPropertyType {
@@ -115,11 +116,21 @@ namespace Mix {
 
         void _deleteMaterial(uint32_t _id);
 
-        void beginRender(const Camera& _camera);
+        /** \brief Upload the per frame data, called on the main thread before any recording. */
+        void beginFrame(const Camera& _camera);
 
-        void render(RenderElement& _renderInfo);
+        /** \brief Upload the changes of _material, called on the main thread before any recording. */
+        void prepareMaterial(Material& _material);
 
-        void endRender();
+        /** \brief Recording functions, may be called from several threads with distinct contexts. */
+        void beginRender(Vulkan::DrawContext& _context);
+
+        void render(Vulkan::DrawContext& _context, RenderElement& _renderInfo);
+
+        /** \brief Draw elements sharing their Mesh, submesh and Material, instanced if the shader supports it. */
+        void renderInstanced(Vulkan::DrawContext& _context, RenderElement* const* _elements, uint32_t _count);
+
+        void endRender(Vulkan::DrawContext& _context);
 
 
     private:
@@ -0,0 +1,207 @@
+#include "MxStaticBatch.h"
+#include "Mesh/MxMesh.h"
+#include "MxMaterial.h"
+#include "../Component/Renderer/MxRenderer.h"
+#include "../Component/MeshFilter/MxMeshFilter.h"
+#include "../GameObject/MxGameObject.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+
+namespace Mix {
+    namespace {
+        /** \brief CPU side data of a batch being built. */
+        struct BatchBuilder {
+            std::shared_ptr<Material> material;
+            Flags<VertexAttribute> attributes;
+
+            std::vector<Mesh::PositionType> positions;
+            std::vector<Mesh::NormalType> normals;
+            std::vector<Mesh::TangentType> tangents;
+            std::vector<Mesh::UV2DType> uv0;
+            std::vector<Mesh::UV2DType> uv1;
+            std::vector<Mesh::ColorType> colors;
+            std::vector<std::vector<uint32_t>> indexSets;
+            std::vector<StaticBatch::Piece> pieces;
+
+            /** \brief Renderer whose vertices were appended last, several of its submeshes may share a Material. */
+            const Renderer* lastRenderer = nullptr;
+            uint32_t lastVertexOffset = 0;
+        };
+
+        std::shared_ptr<Mesh> GetBatchableMesh(Renderer& _renderer) {
+            auto object = _renderer.getGameObject();
+            if (!object->isStatic())
+                return nullptr;
+
+            auto filter = object->getComponent<MeshFilter>();
+            auto mesh = filter ? filter->getMesh() : nullptr;
+            if (!mesh || !mesh->isReadable() || !mesh->hasIndices())
+                return nullptr;
+
+            auto& materials = _renderer.getMaterials();
+            const uint32_t count = std::min(mesh->subMeshCount(), static_cast<uint32_t>(materials.size()));
+            if (count == 0)
+                return nullptr;
+
+            // Transparent pieces have to be sorted one by one
+            for (uint32_t i = 0; i < count; ++i) {
+                if (!materials[i] || materials[i]->getRenderType() == RenderType::Transparent || mesh->getTopology(i) != MeshTopology::Triangles_List)
+                    return nullptr;
+            }
+            return mesh;
+        }
+
+        void AppendVertices(BatchBuilder& _builder, Mesh& _mesh, const Matrix4& _localToWorld) {
+            const Matrix4 normalMatrix = _localToWorld.inverse().transpose();
+
+            for (auto& position : _mesh.getPositions())
+                _builder.positions.push_back(_localToWorld.multiplyPoint(position));
+
+            if (_builder.attributes.isSet(VertexAttribute::Normal)) {
+                for (auto& normal : _mesh.getNormals())
+                    _builder.normals.push_back(normalMatrix.multiplyVector(normal).normalize());
+            }
+            if (_builder.attributes.isSet(VertexAttribute::Tangent)) {
+                for (auto& tangent : _mesh.getTangents())
+                    _builder.tangents.push_back(_localToWorld.multiplyVector(tangent).normalize());
+            }
+            if (_builder.attributes.isSet(VertexAttribute::UV0)) {
+                auto& uvs = _mesh.getUVs(UVChannel::UV0);
+                _builder.uv0.insert(_builder.uv0.end(), uvs.begin(), uvs.end());
+            }
+            if (_builder.attributes.isSet(VertexAttribute::UV1)) {
+                auto& uvs = _mesh.getUVs(UVChannel::UV1);
+                _builder.uv1.insert(_builder.uv1.end(), uvs.begin(), uvs.end());
+            }
+            if (_builder.attributes.isSet(VertexAttribute::Color)) {
+                auto& colors = _mesh.getColors();
+                _builder.colors.insert(_builder.colors.end(), colors.begin(), colors.end());
+            }
+        }
+    }
+
+    std::vector<StaticBatch> StaticBatch::Build(Renderer* const* _renderers, uint32_t _count) {
+        std::vector<BatchBuilder> builders;
+        std::map<std::pair<const Material*, uint32_t>, uint32_t> builderIndices;
+        std::vector<uint32_t> indices;
+
+        for (uint32_t r = 0; r < _count; ++r) {
+            Renderer* renderer = _renderers[r];
+            auto mesh = GetBatchableMesh(*renderer);
+            if (!mesh)
+                continue;
+
+            const Matrix4& localToWorld = renderer->getGameObject()->transform().localToWorldMatrix();
+            auto& materials = renderer->getMaterials();
+            const uint32_t count = std::min(mesh->subMeshCount(), static_cast<uint32_t>(materials.size()));
+
+            for (uint32_t i = 0; i < count; ++i) {
+                const auto key = std::make_pair(materials[i].get(), static_cast<uint32_t>(mesh->getAttributesFlags()));
+                auto it = builderIndices.find(key);
+                if (it == builderIndices.end()) {
+                    it = builderIndices.emplace(key, static_cast<uint32_t>(builders.size())).first;
+                    builders.emplace_back();
+                    builders.back().material = materials[i];
+                    builders.back().attributes = mesh->getAttributesFlags();
+                }
+
+                BatchBuilder& builder = builders[it->second];
+                if (builder.lastRenderer != renderer) {
+                    builder.lastRenderer = renderer;
+                    builder.lastVertexOffset = static_cast<uint32_t>(builder.positions.size());
+                    AppendVertices(builder, *mesh, localToWorld);
+                }
+
+                // Rebase the indices onto the merged vertices, the bounds come from the vertices actually referenced
+                mesh->getIndices(indices, i);
+                const uint32_t offset = builder.lastVertexOffset + mesh->getSubMesh(i).baseVertex;
+                Vector3f min(std::numeric_limits<float>::max());
+                Vector3f max(std::numeric_limits<float>::lowest());
+                for (auto& index : indices) {
+                    index += offset;
+                    const auto& position = builder.positions[index];
+                    min = Vector3f(std::min(min.x, position.x), std::min(min.y, position.y), std::min(min.z, position.z));
+                    max = Vector3f(std::max(max.x, position.x), std::max(max.y, position.y), std::max(max.z, position.z));
+                }
+
+                builder.indexSets.push_back(indices);
+                builder.pieces.push_back(Piece{ renderer, AABB(min, max) });
+            }
+
+            renderer->mStaticBatched = true;
+        }
+
+        std::vector<StaticBatch> batches(builders.size());
+        for (size_t b = 0; b < builders.size(); ++b) {
+            BatchBuilder& builder = builders[b];
+            StaticBatch& batch = batches[b];
+
+            auto mesh = std::make_shared<Mesh>();
+            mesh->setPositions(std::move(builder.positions));
+            mesh->setNormals(std::move(builder.normals));
+            mesh->setTangents(std::move(builder.tangents));
+            mesh->setUVs(UVChannel::UV0, std::move(builder.uv0));
+            mesh->setUVs(UVChannel::UV1, std::move(builder.uv1));
+            mesh->setColors(std::move(builder.colors));
+            for (uint32_t i = 0; i < builder.indexSets.size(); ++i)
+                mesh->setIndices(std::move(builder.indexSets[i]), MeshTopology::Triangles_List, i);
+            mesh->uploadMeshData(true);
+
+            Vector3f min = builder.pieces.front().bounds.getMin();
+            Vector3f max = builder.pieces.front().bounds.getMax();
+            batch.mPieceBounds.reserve(static_cast<uint32_t>(builder.pieces.size()));
+            for (auto& piece : builder.pieces) {
+                batch.mPieceBounds.push(piece.bounds);
+                const auto& pieceMin = piece.bounds.getMin();
+                const auto& pieceMax = piece.bounds.getMax();
+                min = Vector3f(std::min(min.x, pieceMin.x), std::min(min.y, pieceMin.y), std::min(min.z, pieceMin.z));
+                max = Vector3f(std::max(max.x, pieceMax.x), std::max(max.y, pieceMax.y), std::max(max.z, pieceMax.z));
+            }
+
+            batch.mMesh = std::move(mesh);
+            batch.mMaterial = std::move(builder.material);
+            batch.mPieces = std::move(builder.pieces);
+            batch.mBounds = AABB(min, max);
+        }
+
+        return batches;
+    }
+
+    void StaticBatch::release() {
+        for (auto& piece : mPieces) {
+            if (piece.renderer)
+                piece.renderer->mStaticBatched = false;
+        }
+        mPieces.clear();
+        mPieceBounds.clear();
+    }
+
+    void StaticBatch::getVisibleRuns(uint32_t _activeRendererCount, const std::vector<uint8_t>& _pieceVisible, std::vector<std::pair<uint32_t, uint32_t>>& _runs) const {
+        const uint32_t count = static_cast<uint32_t>(mPieces.size());
+        uint32_t first = 0;
+        while (first < count) {
+            // A Renderer outside the active range is disabled or its GameObject is inactive
+            auto visible = [&](uint32_t _piece) {
+                const Renderer* renderer = mPieces[_piece].renderer;
+                return renderer && renderer->mRenderIndex < _activeRendererCount && _pieceVisible[_piece];
+            };
+
+            while (first < count && !visible(first))
+                ++first;
+            uint32_t last = first;
+            while (last < count && visible(last))
+                ++last;
+            if (last > first)
+                _runs.emplace_back(first, last - first);
+            first = last;
+        }
+    }
+
+    void StaticBatch::removeRenderer(const Renderer* _renderer) {
+        for (auto& piece : mPieces) {
+            if (piece.renderer == _renderer)
+                piece.renderer = nullptr;
+        }
+    }
+}
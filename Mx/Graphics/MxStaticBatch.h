@@ -0,0 +1,74 @@
+#pragma once
+#ifndef MX_STATIC_BATCH_H_
+#define MX_STATIC_BATCH_H_
+
+#include "../Math/MxAABB.h"
+#include "MxCullingBounds.h"
+#include <memory>
+#include <vector>
+
+namespace Mix {
+    class Mesh;
+    class Material;
+    class Renderer;
+
+    /**
+     * \brief The meshes of static Renderers sharing a Material, merged into one Mesh pre-transformed to world space.
+     *
+     *        Every submesh of a source Renderer becomes a piece, i.e. a submesh of the merged Mesh. Pieces are laid
+     *        out back to back in the index buffer with no base vertex, so a run of consecutive pieces is drawn with
+     *        a single call. A piece is drawn while its Renderer is enabled and active in hierarchy and the
+     *        piece is in view.
+     *
+     * \note  Moving a static GameObject, or changing its Mesh or Materials, after the batches were built has no
+     *        visible effect until Scene::buildStaticBatches() is called again.
+     */
+    class StaticBatch {
+    public:
+        struct Piece {
+            /** \brief The source Renderer, nullptr once it left the scene. */
+            Renderer* renderer;
+            AABB bounds;
+        };
+
+        /**
+         * \brief Merge every Renderer of a GameObject flagged IsStatic whose Mesh is still readable.
+         * \return One batch per Material and vertex layout. Merged Renderers are flagged, Graphics skips them.
+         */
+        static std::vector<StaticBatch> Build(Renderer* const* _renderers, uint32_t _count);
+
+        /** \brief Clear the flag set by Build() on every Renderer still in a piece. */
+        void release();
+
+        const std::shared_ptr<Mesh>& getMesh() const { return mMesh; }
+
+        const std::shared_ptr<Material>& getMaterial() const { return mMaterial; }
+
+        const std::vector<Piece>& getPieces() const { return mPieces; }
+
+        /** \brief World space bounds of all pieces. */
+        const AABB& getBounds() const { return mBounds; }
+
+        /** \brief The bounds of every piece, in piece order. */
+        const CullingBounds& getPieceBounds() const { return mPieceBounds; }
+
+        /**
+         * \brief Append a (first piece, piece count) pair to _runs for every run of consecutive pieces to draw.
+         * \param _activeRendererCount Size of the active range of the scene, see SceneRenderInfo.
+         * \param _pieceVisible Result of testing getPieceBounds() against the view frustum.
+         */
+        void getVisibleRuns(uint32_t _activeRendererCount, const std::vector<uint8_t>& _pieceVisible, std::vector<std::pair<uint32_t, uint32_t>>& _runs) const;
+
+        /** \brief Stop drawing the pieces of _renderer, called when it leaves the scene. */
+        void removeRenderer(const Renderer* _renderer);
+
+    private:
+        std::shared_ptr<Mesh> mMesh;
+        std::shared_ptr<Material> mMaterial;
+        std::vector<Piece> mPieces;
+        CullingBounds mPieceBounds;
+        AABB mBounds;
+    };
+}
+
+#endif
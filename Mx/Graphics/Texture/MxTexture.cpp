@@ -7,6 +7,10 @@
 #include "../../Vulkan/MxVulkan.h"
 
 namespace Mix {
+    MX_IMPLEMENT_RTTI(Texture, ResourceBase);
+    MX_IMPLEMENT_RTTI(Texture2D, Texture);
+    MX_IMPLEMENT_RTTI(CubeMap, Texture);
+
     Texture::~Texture() {
         auto device = mImage->getAllocator()->getDevice();
         if (mImageView)
@@ -26,6 +26,7 @@ namespace Mix {
 	};
 
 	class Texture :public ResourceBase, public Vulkan::Descriptor, public GeneralBase::NoCopyBase {
+		MX_DECLARE_RTTI;
 	public:
         virtual ~Texture();
 
@@ -102,6 +103,7 @@ namespace Mix {
 	};
 
 	class Texture2D final :public Texture {
+		MX_DECLARE_RTTI;
 	public:
 		Texture2D(uint32_t _width,
 				  uint32_t _height,
@@ -121,6 +123,7 @@ namespace Mix {
 	};
 
 	class CubeMap :public Texture {
+		MX_DECLARE_RTTI;
 	public:
 		CubeMap(uint32_t _width,
 				TextureFormat _format,
@@ -1,4 +1,6 @@
 #include "MxAABB.h"
+#include <algorithm>
+#include <cmath>
 
 namespace Mix {
 
@@ -62,7 +64,7 @@ namespace Mix {
             (mMax.y < _other.mMin.y) ||
             (mMax.z < _other.mMin.z) ||
             (mMin.x > _other.mMax.x) ||
-            (mMin.x > _other.mMax.x) ||
+            (mMin.y > _other.mMax.y) ||
             (mMin.z > _other.mMax.z)
             );
     }
@@ -90,6 +92,61 @@ namespace Mix {
             _other.mMax.z <= mMax.z;
     }
 
+    bool AABB::intersects(const Vector3f& _center, const float _radius) const {
+        // Distance from the center to the closest point of the box
+        const float dx = std::max(std::max(mMin.x - _center.x, 0.0f), _center.x - mMax.x);
+        const float dy = std::max(std::max(mMin.y - _center.y, 0.0f), _center.y - mMax.y);
+        const float dz = std::max(std::max(mMin.z - _center.z, 0.0f), _center.z - mMax.z);
+        return dx * dx + dy * dy + dz * dz <= _radius * _radius;
+    }
+
+    bool AABB::intersectsRay(const Vector3f& _origin, const Vector3f& _invDirection, const float _maxDistance, float& _distance) const {
+        float tMin = 0.0f;
+        float tMax = _maxDistance;
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            float t0 = (mMin[axis] - _origin[axis]) * _invDirection[axis];
+            float t1 = (mMax[axis] - _origin[axis]) * _invDirection[axis];
+            if (t0 > t1)
+                std::swap(t0, t1);
+            tMin = std::max(tMin, t0);
+            tMax = std::min(tMax, t1);
+            if (tMin > tMax)
+                return false;
+        }
+        _distance = tMin;
+        return true;
+    }
+
+    AABB& AABB::merge(const AABB& _other) {
+        mMin = Vector3f(std::min(mMin.x, _other.mMin.x), std::min(mMin.y, _other.mMin.y), std::min(mMin.z, _other.mMin.z));
+        mMax = Vector3f(std::max(mMax.x, _other.mMax.x), std::max(mMax.y, _other.mMax.y), std::max(mMax.z, _other.mMax.z));
+        return *this;
+    }
+
+    AABB& AABB::expand(const float _margin) {
+        mMin -= Vector3f(_margin);
+        mMax += Vector3f(_margin);
+        return *this;
+    }
+
+    float AABB::surfaceArea() const {
+        const Vector3f extent = getExtent();
+        return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+    }
+
+    AABB AABB::transformed(const Matrix4& _matrix) const {
+        // Transform the center, the absolute value of the linear part maps the half extent
+        const Vector3f center = _matrix.multiplyPoint(getCenter());
+        const Vector3f half = getExtent() * 0.5f;
+        Vector3f extent;
+        for (uint32_t row = 0; row < 3; ++row) {
+            extent[row] = std::abs(_matrix[0][row]) * half.x +
+                std::abs(_matrix[1][row]) * half.y +
+                std::abs(_matrix[2][row]) * half.z;
+        }
+        return AABB(center - extent, center + extent);
+    }
+
     bool AABB::operator==(const AABB& _other) const {
         return mMin == _other.mMin && mMax == _other.mMax;
     }
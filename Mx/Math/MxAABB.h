@@ -71,6 +71,29 @@ namespace Mix {
 
         bool contains(const AABB& _other) const;
 
+        /** \brief Check if the box overlaps the sphere. */
+        bool intersects(const Vector3f& _center, const float _radius) const;
+
+        /**
+         * \brief Slab test of a ray against the box.
+         * \param _invDirection 1 / direction of the ray, per component.
+         * \param _distance Distance along the ray at which it enters the box, 0 if the origin is inside.
+         */
+        bool intersectsRay(const Vector3f& _origin, const Vector3f& _invDirection, const float _maxDistance, float& _distance) const;
+
+        /** \brief Grow this box to enclose _other. */
+        AABB& merge(const AABB& _other);
+
+        /** \brief Grow this box by _margin on every side. */
+        AABB& expand(const float _margin);
+
+        float surfaceArea() const;
+
+        /** \brief Get the box enclosing this one once transformed by _matrix. */
+        AABB transformed(const Matrix4& _matrix) const;
+
+        static AABB Merge(const AABB& _a, const AABB& _b) { return AABB(_a).merge(_b); }
+
         bool operator==(const AABB& _other) const;
 
         bool operator!=(const AABB& _other) const { return !(*this == _other); }
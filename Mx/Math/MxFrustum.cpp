@@ -0,0 +1,50 @@
+#include "MxFrustum.h"
+
+namespace Mix {
+    Frustum::Frustum(const Matrix4& _viewProj) {
+        // Rows of a column-major matrix
+        auto row = [&_viewProj](const uint32_t _row) {
+            return Vector4f(_viewProj[0][_row], _viewProj[1][_row], _viewProj[2][_row], _viewProj[3][_row]);
+        };
+        const Vector4f r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+        // The near plane is the -1 one of an OpenGL depth range, which is conservative for a [0, 1] one
+        const Vector4f planes[SideCount] = { r3 + r0, r3 - r0, r3 + r1, r3 - r1, r3 + r2, r3 - r2 };
+
+        for (uint32_t i = 0; i < SideCount; ++i) {
+            const Vector3f normal(planes[i]);
+            const float length = normal.length();
+            mPlanes[i] = Plane(normal / length, planes[i].w / length);
+        }
+    }
+
+    bool Frustum::contains(const Vector3f& _point) const {
+        for (auto& plane : mPlanes) {
+            if (plane.getDistance(_point) < 0.0f)
+                return false;
+        }
+        return true;
+    }
+
+    bool Frustum::intersects(const AABB& _box) const {
+        const Vector3f& min = _box.getMin();
+        const Vector3f& max = _box.getMax();
+        for (auto& plane : mPlanes) {
+            // The corner furthest along the normal
+            const Vector3f corner(plane.normal.x >= 0.0f ? max.x : min.x,
+                                  plane.normal.y >= 0.0f ? max.y : min.y,
+                                  plane.normal.z >= 0.0f ? max.z : min.z);
+            if (plane.getDistance(corner) < 0.0f)
+                return false;
+        }
+        return true;
+    }
+
+    bool Frustum::intersects(const Vector3f& _center, const float _radius) const {
+        for (auto& plane : mPlanes) {
+            if (plane.getDistance(_center) < -_radius)
+                return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#ifndef MX_FRUSTUM_H_
+#define MX_FRUSTUM_H_
+
+#include "MxAABB.h"
+#include <array>
+
+namespace Mix {
+    /** \brief Plane of the points p such that dot(normal, p) + distance == 0, normal points to the positive side. */
+    struct Plane {
+        Plane() = default;
+
+        Plane(const Vector3f& _normal, const float _distance) :normal(_normal), distance(_distance) {}
+
+        float getDistance(const Vector3f& _point) const { return normal.dot(_point) + distance; }
+
+        Vector3f normal = Vector3f::Up;
+        float distance = 0.0f;
+    };
+
+    class Frustum {
+    public:
+        enum Side {
+            Left,
+            Right,
+            Bottom,
+            Top,
+            Near,
+            Far,
+            SideCount
+        };
+
+        Frustum() = default;
+
+        /** \brief Extract the planes of a view-projection matrix, normals point inside. */
+        explicit Frustum(const Matrix4& _viewProj);
+
+        const Plane& getPlane(Side _side) const { return mPlanes[_side]; }
+
+        bool contains(const Vector3f& _point) const;
+
+        /** \brief Conservative test, a box crossing no plane but outside the corners of the frustum still passes. */
+        bool intersects(const AABB& _box) const;
+
+        bool intersects(const Vector3f& _center, const float _radius) const;
+
+    private:
+        std::array<Plane, SideCount> mPlanes;
+    };
+}
+
+#endif
@@ -0,0 +1,21 @@
+#pragma once
+#ifndef MX_RAY_H_
+#define MX_RAY_H_
+
+#include "MxVector3.h"
+
+namespace Mix {
+    struct Ray {
+        Ray() = default;
+
+        /** \param _direction Expected to be normalized, distances along the ray are measured with it. */
+        Ray(const Vector3f& _origin, const Vector3f& _direction) :origin(_origin), direction(_direction) {}
+
+        Vector3f getPoint(const float _distance) const { return origin + direction * _distance; }
+
+        Vector3f origin = Vector3f::Zero;
+        Vector3f direction = Vector3f::Forward;
+    };
+}
+
+#endif
@@ -5,6 +5,7 @@
 
 #include <map>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 #include "../Rtti/MxRtti.hpp"
@@ -70,6 +71,25 @@ namespace Mix {
          */
         const std::string& getTypeName() const { return getType().getName(); }
     };
+
+    /**
+     *  @brief Cast _ptr to _To if the object is a _To or derived from it, otherwise return nullptr.
+     *  @note  Replaces dynamic_cast for Objects. _To must declare its own Rtti.
+     */
+    template<typename _To, typename _From>
+    _To* rtti_cast(_From* _ptr) noexcept {
+        static_assert(std::is_base_of_v<Object, _From> && std::is_base_of_v<Object, _To>, "rtti_cast only works with Objects");
+
+        return _ptr != nullptr && _ptr->getType().isA(_To::GetType()) ? static_cast<_To*>(_ptr) : nullptr;
+    }
+
+    /**
+     *  @brief shared_ptr version of rtti_cast.
+     */
+    template<typename _To, typename _From>
+    std::shared_ptr<_To> rtti_pointer_cast(const std::shared_ptr<_From>& _ptr) noexcept {
+        return rtti_cast<_To>(_ptr.get()) != nullptr ? std::static_pointer_cast<_To>(_ptr) : nullptr;
+    }
 }
 
 #endif
@@ -2,8 +2,11 @@
 #include "../../GameObject/MxGameObject.h"
 #include "../../Component/MeshFilter/MxMeshFilter.h"
 #include "../../Scene/MxSceneManager.h"
+#include "../Prefab/MxPrefab.h"
 
 namespace Mix {
+    MX_IMPLEMENT_RTTI(Model, ResourceBase);
+
     void Model::Node::addChildNode(const Node& _node) {
         if (!mChildren.has_value())
             mChildren.emplace();
@@ -80,5 +83,39 @@ namespace Mix {
             }
         }
     }
-}
 
+    std::shared_ptr<Prefab> Model::createPrefab(const std::string& _name,
+                                                const Tag& _tag,
+                                                LayerIndex _layerIndex,
+                                                Flags<GameObjectFlags> _flags) const {
+        if (!mRootNode.hasChildNode())
+            return nullptr;
+
+        auto prefab = std::make_shared<Prefab>(_name);
+        const Node& root = mRootNode.getChildNodes()[0];
+        prefab->addNode(Prefab::InvalidIndex, _name, _tag, _layerIndex, _flags, root.getTranslation(), root.getRotation(), root.getScale());
+        recurBuildPrefab(*prefab, 0, root);
+        return prefab;
+    }
+
+    void Model::recurBuildPrefab(Prefab& _prefab, uint32_t _parent, const Node& _node) const {
+        // Same payload as the MeshFilter serializer writes, a single mesh reference
+        if (_node.getMeshRef() > -1) {
+            const auto mesh = mMeshes[_node.getMeshRef()];
+            _prefab.addComponent(*ComponentSerializers::Get().find(MeshFilter::GetType()),
+                                 [&mesh](ScenePayloadWriter& _writer) { _writer.writeResource(mesh); });
+        }
+
+        if (!_node.hasChildNode())
+            return;
+
+        const auto& parent = _prefab.mNodes[_parent];
+        const Tag tag = parent.tag;
+        const LayerIndex layer = parent.layer;
+        const Flags<GameObjectFlags> flags = parent.flags;
+        for (auto& child : _node.getChildNodes()) {
+            const uint32_t index = _prefab.addNode(_parent, child.getName(), tag, layer, flags, child.getTranslation(), child.getRotation(), child.getScale());
+            recurBuildPrefab(_prefab, index, child);
+        }
+    }
+}
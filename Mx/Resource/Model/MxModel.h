@@ -10,9 +10,11 @@
 
 namespace Mix {
     class GameObject;
+    class Prefab;
     struct GameObjectConInfo;
 
     class Model :public ResourceBase {
+        MX_DECLARE_RTTI;
         friend class ModelParserBase;
     public:
         /**
@@ -117,12 +119,23 @@ namespace Mix {
                                           LayerIndex _layerIndex        = 0,
                                           Flags<GameObjectFlags> _flags = {}) const;
 
+        /**
+         * \brief Capture the node hierarchy as a Prefab, to instantiate the model many times at a low cost.
+         *        Node transforms are kept as local transforms.
+         */
+        std::shared_ptr<Prefab> createPrefab(const std::string& _name,
+                                             const Tag& _tag               = "",
+                                             LayerIndex _layerIndex        = 0,
+                                             Flags<GameObjectFlags> _flags = {}) const;
+
     private:
         std::string mName;
         Node mRootNode;
         std::vector<std::shared_ptr<Mesh>> mMeshes;
 
         void recurBuildGameObj(const std::shared_ptr<Scene>& _scene, const HGameObject& _obj, const Node& _node) const;
+
+        void recurBuildPrefab(Prefab& _prefab, uint32_t _parent, const Node& _node) const;
     };
 }
 #endif
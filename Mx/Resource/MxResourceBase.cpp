@@ -1,5 +1,5 @@
 #include "MxResourceBase.h"
 
 namespace Mix {
-    
+    MX_IMPLEMENT_RTTI(ResourceBase, Object);
 }
\ No newline at end of file
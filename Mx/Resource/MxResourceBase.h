@@ -59,7 +59,8 @@ namespace Mix {
         }
     }
 
-    class ResourceBase {
+    class ResourceBase : public Object {
+        MX_DECLARE_RTTI;
     public:
         ResourceBase() = default;
         virtual ~ResourceBase() = default;
@@ -5,10 +5,9 @@
 #include "MxResourceParserBase.hpp"
 #include "MxParserRegister.hpp"
 #include "../Engine/MxModuleBase.h"
+#include "MxResourceBase.h"
 
 namespace Mix {
-	class ResourceBase;
-
 	class ResourceLoader : public ModuleBase {
 	public:
 		static ResourceLoader* Get();
@@ -57,12 +56,12 @@ namespace Mix {
 
 	template <typename _Ty>
 	std::shared_ptr<_Ty> ResourceLoader::load(const std::string& _file, void* _additionalParam) const {
-		return std::dynamic_pointer_cast<_Ty>(load(_file, _additionalParam));
+		return rtti_pointer_cast<_Ty>(load(_file, _additionalParam));
 	}
 
 	template <typename _Ty>
 	std::shared_ptr<_Ty> ResourceLoader::load(const std::string& _file, const ResourceType _type, void* _additionalParam) {
-		return std::dynamic_pointer_cast<_Ty>(load(_file, _type, _additionalParam));
+		return rtti_pointer_cast<_Ty>(load(_file, _type, _additionalParam));
 	}
 }
 
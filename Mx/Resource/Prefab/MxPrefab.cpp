@@ -0,0 +1,269 @@
+#include "MxPrefab.h"
+#include "../../Scene/MxSceneManager.h"
+#include "../../Component/Transform/MxTransformSystem.h"
+#include "../../Component/Renderer/MxRenderer.h"
+#include "../../Component/RigidBody/MxRigidBody.h"
+#include "../../Physics/MxPhysicsUtils.hpp"
+#include "../../Physics/MxRigidBodyUtils.hpp"
+#include "../../Log/MxLog.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace Mix {
+    MX_IMPLEMENT_RTTI(Prefab, ResourceBase);
+
+    std::shared_ptr<Prefab> Prefab::Capture(const HGameObject& _root) {
+        if (!_root)
+            return nullptr;
+
+        auto prefab = std::make_shared<Prefab>(_root->getName());
+        std::unordered_set<const Rtti*> skippedTypes;
+
+        // Pre-order, each entry is a GameObject and the index of its parent node
+        std::vector<std::pair<GameObject*, uint32_t>> stack{ { _root.operator->(), InvalidIndex } };
+        while (!stack.empty()) {
+            const auto [object, parent] = stack.back();
+            stack.pop_back();
+
+            const Transform& transform = object->transform();
+            const uint32_t index = prefab->addNode(parent,
+                                                   object->getName(),
+                                                   object->getTag(),
+                                                   object->getLayer(),
+                                                   object->getFlags(),
+                                                   transform.getLocalPosition(),
+                                                   transform.getLocalRotation(),
+                                                   transform.getLocalScale());
+            prefab->mNodes[index].activeSelf = object->activeSelf();
+
+            for (auto& handle : object->_getComponents()) {
+                const Component& component = *handle;
+                if (component.isSameType(Transform::GetType()))
+                    continue;
+
+                if (auto entry = ComponentSerializers::Get().find(component.getType())) {
+                    prefab->addComponent(*entry, [&](ScenePayloadWriter& _writer) { entry->write(component, _writer); });
+
+                    if (component.isSameType(Renderer::GetType())) {
+                        const auto& materials = static_cast<const Renderer&>(component).getMaterials();
+                        auto& renderer = prefab->mComponents.back();
+                        renderer.firstMaterial = static_cast<uint32_t>(prefab->mMaterials.size());
+                        renderer.materialCount = static_cast<uint32_t>(materials.size());
+                        prefab->mMaterials.insert(prefab->mMaterials.end(), materials.begin(), materials.end());
+                    }
+                    continue;
+                }
+
+                auto captureType = CaptureTypes().find(&component.getType());
+                ComponentFactory factory;
+                if (captureType != CaptureTypes().end())
+                    factory = captureType->second.capture(component);
+
+                if (!factory) {
+                    if (skippedTypes.insert(&component.getType()).second)
+                        MX_LOG_WARNING("Components of type [%1%] can't be captured by a Prefab and are skipped, see Prefab::RegisterType().", component.getTypeName());
+                    continue;
+                }
+
+                prefab->addComponent(std::move(factory), captureType->second.reserve);
+            }
+
+            for (uint32_t i = object->getChildrenCount(); i-- > 0;)
+                stack.emplace_back(object->getChild(i).operator->(), index);
+        }
+
+        return prefab;
+    }
+
+    std::unordered_map<const Rtti*, Prefab::CaptureType>& Prefab::CaptureTypes() {
+        static std::unordered_map<const Rtti*, CaptureType> types = [] {
+            std::unordered_map<const Rtti*, CaptureType> defaults;
+            defaults[&RigidBody::GetType()] = CaptureType{
+                [](const Component& _component) { return CaptureRigidBody(static_cast<const RigidBody&>(_component)); },
+                [](uint32_t _count) { ComponentPool<RigidBody>::Get().reserve(_count); } };
+            return defaults;
+        }();
+        return types;
+    }
+
+    Prefab::ComponentFactory Prefab::CaptureRigidBody(const RigidBody& _rigidBody) {
+        // A RigidBody made by the default ctor has nothing to copy
+        btRigidBody* body = _rigidBody.mRigidBody;
+        if (!body)
+            return nullptr;
+
+        const btScalar mass = _rigidBody.mMass;
+        const std::shared_ptr<btCollisionShape> ownedShape = _rigidBody.mShape;
+        btCollisionShape* shape = body->getCollisionShape();
+        const auto filter = _rigidBody.mFilter;
+        const auto motionState = static_cast<const Physics::MotionState*>(body->getMotionState());
+        const auto interpolation = motionState ? motionState->interpolation() : Physics::RigidbodyInterpolation::None;
+
+        const btScalar friction = body->getFriction();
+        const btScalar rollingFriction = body->getRollingFriction();
+        const btScalar restitution = body->getRestitution();
+        const btScalar linearDamping = body->getLinearDamping();
+        const btScalar angularDamping = body->getAngularDamping();
+        const btScalar linearSleepingThreshold = body->getLinearSleepingThreshold();
+        const btScalar angularSleepingThreshold = body->getAngularSleepingThreshold();
+        const btVector3 linearFactor = body->getLinearFactor();
+        const btVector3 angularFactor = body->getAngularFactor();
+        const bool kinematic = _rigidBody.isKinematic();
+        const bool trigger = _rigidBody.isTrigger();
+        const bool madeStatic = _rigidBody.isStatic() && mass > FLT_EPSILON;
+
+        return [=](GameObject& _object) {
+            Physics::RigidBodyConstructionInfo info(mass, Physics::mx_bt_cast(_object.transform()), shape);
+            info.interpolation = interpolation;
+            info.furtherSetup = [=](btRigidBody::btRigidBodyConstructionInfo& _info) {
+                _info.m_friction = friction;
+                _info.m_rollingFriction = rollingFriction;
+                _info.m_restitution = restitution;
+                _info.m_linearDamping = linearDamping;
+                _info.m_angularDamping = angularDamping;
+                _info.m_linearSleepingThreshold = linearSleepingThreshold;
+                _info.m_angularSleepingThreshold = angularSleepingThreshold;
+            };
+
+            auto rigidBody = std::get<0>(filter)
+                                 ? _object.addComponent<RigidBody>(info, std::get<1>(filter), std::get<2>(filter))
+                                 : _object.addComponent<RigidBody>(info);
+            rigidBody->mShape = ownedShape;
+            rigidBody->mRigidBody->setLinearFactor(linearFactor);
+            rigidBody->mRigidBody->setAngularFactor(angularFactor);
+            if (kinematic)
+                rigidBody->setKinematic(true);
+            if (trigger)
+                rigidBody->setTrigger(true);
+            if (madeStatic)
+                rigidBody->setStatic(true);
+        };
+    }
+
+    std::vector<HGameObject> Prefab::instantiate(uint32_t _count, const std::vector<InstanceTransform>& _transforms) const {
+        return instantiate(SceneManager::Get()->getActiveScene(), _count, _transforms);
+    }
+
+    std::vector<HGameObject> Prefab::instantiate(const std::shared_ptr<Scene>& _scene, uint32_t _count, const std::vector<InstanceTransform>& _transforms) const {
+        std::vector<HGameObject> roots;
+        if (_count == 0 || mNodes.empty())
+            return roots;
+
+        // Every allocation the instances need is made here instead of once per object
+        const uint32_t objectCount = _count * static_cast<uint32_t>(mNodes.size());
+        SceneObjectManager::Get()->reserve(objectCount * 2 + _count * static_cast<uint32_t>(mComponents.size()));
+        TransformSystem::Get()->reserve(objectCount);
+        ComponentPool<Transform>::Get().reserve(objectCount);
+        for (const auto& [reserve, count] : mComponentCounts)
+            reserve(count * _count);
+
+        roots.reserve(_count);
+        std::vector<HGameObject> objects(mNodes.size());
+
+        for (uint32_t instance = 0; instance < _count; ++instance) {
+            for (uint32_t i = 0; i < mNodes.size(); ++i) {
+                const Node& node = mNodes[i];
+                const HGameObject parent = node.parent != InvalidIndex ? objects[node.parent] : HGameObject();
+
+                auto object = GameObject::CreateInHierarchy(_scene, parent, node.name, node.tag, node.layer, node.flags);
+                object->mChildren.reserve(node.childCount);
+
+                Transform& transform = object->transform();
+                if (i == 0 && instance < _transforms.size()) {
+                    transform.setLocalPosition(_transforms[instance].position);
+                    transform.setLocalRotation(_transforms[instance].rotation);
+                    transform.setLocalScale(_transforms[instance].scale);
+                }
+                else {
+                    transform.setLocalPosition(node.localPosition);
+                    transform.setLocalRotation(node.localRotation);
+                    transform.setLocalScale(node.localScale);
+                }
+
+                for (uint32_t c = node.firstComponent; c < node.firstComponent + node.componentCount; ++c) {
+                    const auto& component = mComponents[c];
+                    if (!component.entry) {
+                        mFactories[component.factory](*object);
+                        continue;
+                    }
+
+                    ScenePayloadReader reader(mPayload.data() + component.payloadOffset, component.payloadSize, mResources, true);
+                    component.entry->create(*object, reader);
+
+                    if (component.materialCount != 0) {
+                        auto& renderer = static_cast<Renderer&>(*object->_getComponents().back());
+                        const auto first = mMaterials.begin() + component.firstMaterial;
+                        renderer.setMaterials(std::vector<std::shared_ptr<Material>>(first, first + component.materialCount));
+                    }
+                }
+
+                if (!node.activeSelf)
+                    object->setActive(false);
+
+                objects[i] = object;
+            }
+            roots.push_back(objects[0]);
+        }
+
+        return roots;
+    }
+
+    uint32_t Prefab::addNode(uint32_t _parent, const std::string& _name, const Tag& _tag, LayerIndex _layer, Flags<GameObjectFlags> _flags,
+                             const Vector3f& _position, const Quaternion& _rotation, const Vector3f& _scale) {
+        if (_parent != InvalidIndex)
+            ++mNodes[_parent].childCount;
+
+        Node node;
+        node.parent = _parent;
+        node.name = _name;
+        node.tag = _tag;
+        node.layer = _layer;
+        node.flags = _flags;
+        node.localPosition = _position;
+        node.localRotation = _rotation;
+        node.localScale = _scale;
+        node.firstComponent = static_cast<uint32_t>(mComponents.size());
+        mNodes.push_back(std::move(node));
+        return static_cast<uint32_t>(mNodes.size() - 1);
+    }
+
+    void Prefab::addComponent(const ComponentSerializers::Entry& _entry, const std::function<void(ScenePayloadWriter&)>& _write) {
+        ScenePayloadWriter writer([this](const std::shared_ptr<ResourceBase>& _resource) { return resourceIndex(_resource); }, mPayload);
+
+        ComponentTemplate component{ &_entry, static_cast<uint32_t>(mPayload.size()), 0 };
+        _write(writer);
+        component.payloadSize = static_cast<uint32_t>(mPayload.size()) - component.payloadOffset;
+        mComponents.push_back(component);
+        ++mNodes.back().componentCount;
+        countComponent(_entry.reserve);
+    }
+
+    void Prefab::addComponent(ComponentFactory _factory, ComponentSerializers::ReserveFunc _reserve) {
+        ComponentTemplate component{ nullptr, 0, 0 };
+        component.factory = static_cast<uint32_t>(mFactories.size());
+        mFactories.push_back(std::move(_factory));
+        mComponents.push_back(component);
+        ++mNodes.back().componentCount;
+        countComponent(_reserve);
+    }
+
+    void Prefab::countComponent(ComponentSerializers::ReserveFunc _reserve) {
+        auto it = std::find_if(mComponentCounts.begin(), mComponentCounts.end(), [_reserve](const auto& _count) { return _count.first == _reserve; });
+        if (it != mComponentCounts.end())
+            ++it->second;
+        else
+            mComponentCounts.emplace_back(_reserve, 1);
+    }
+
+    uint32_t Prefab::resourceIndex(const std::shared_ptr<ResourceBase>& _resource) {
+        if (!_resource)
+            return SceneFormat::InvalidIndex;
+
+        auto it = std::find(mResources.begin(), mResources.end(), _resource);
+        if (it != mResources.end())
+            return static_cast<uint32_t>(it - mResources.begin());
+
+        mResources.push_back(_resource);
+        return static_cast<uint32_t>(mResources.size() - 1);
+    }
+}
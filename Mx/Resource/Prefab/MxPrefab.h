@@ -0,0 +1,160 @@
+#pragma once
+#ifndef MX_PREFAB_H_
+#define MX_PREFAB_H_
+
+#include "../MxResourceBase.h"
+#include "../../Math/MxVector3.h"
+#include "../../Math/MxQuaternion.h"
+#include "../../GameObject/MxGameObject.h"
+#include "../../Scene/MxSceneSerializer.h"
+#include <unordered_map>
+
+namespace Mix {
+    class Scene;
+    class Model;
+    class Material;
+    class RigidBody;
+
+    /**
+     * \brief A GameObject hierarchy captured once as a flat template, to be instantiated many times.
+     *
+     *        Nodes are stored in pre-order so a parent always precedes its children. Components are kept
+     *        as payloads of the ComponentSerializers, Materials of Renderers are shared by every instance.
+     *        Types the serializers don't know, such as Behaviours, are captured through RegisterType(),
+     *        RigidBody is registered by default. Instances never take over the main camera of the scene.
+     *        Instantiating N copies reserves every pool involved up front and builds each hierarchy in
+     *        place, without the world transform fix-up of GameObject::setParent().
+     */
+    class Prefab :public ResourceBase {
+        MX_DECLARE_RTTI;
+        friend class Model;
+    public:
+        /** \brief Local transform given to the root GameObject of an instance. */
+        struct InstanceTransform {
+            Vector3f position = Vector3f::Zero;
+            Quaternion rotation = Quaternion::Identity;
+            Vector3f scale = Vector3f::One;
+        };
+
+        /** \brief Adds a captured Component to a GameObject of an instance. */
+        using ComponentFactory = std::function<void(GameObject&)>;
+
+        /**
+         * \brief Let Prefabs capture Components of type _Ty that have no ComponentSerializers entry.
+         * \param _capture Called once per captured Component, the returned factory is run for every instance.
+         */
+        template<typename _Ty>
+        static void RegisterType(std::function<ComponentFactory(const _Ty&)> _capture);
+
+        /** \brief Capture Components of type _Ty by adding a default constructed one to every instance. */
+        template<typename _Ty>
+        static void RegisterType();
+
+        Prefab() = default;
+
+        explicit Prefab(std::string _name) :mName(std::move(_name)) {}
+
+        /** \brief Capture _root and all its descendants. */
+        static std::shared_ptr<Prefab> Capture(const HGameObject& _root);
+
+        void setName(const std::string& _name) { mName = _name; }
+
+        const std::string& getName() const { return mName; }
+
+        /** \brief Get the amount of GameObjects in one instance. */
+        uint32_t objectCount() const { return static_cast<uint32_t>(mNodes.size()); }
+
+        /**
+         * \brief Create _count copies of the hierarchy in the active scene.
+         * \param _transforms Local transforms of the instance roots, instances beyond its size keep the captured one.
+         * \return The root GameObject of every instance.
+         */
+        std::vector<HGameObject> instantiate(uint32_t _count, const std::vector<InstanceTransform>& _transforms = {}) const;
+
+        std::vector<HGameObject> instantiate(const std::shared_ptr<Scene>& _scene, uint32_t _count, const std::vector<InstanceTransform>& _transforms = {}) const;
+
+    private:
+        static constexpr uint32_t InvalidIndex = ~0u;
+
+        struct Node {
+            uint32_t parent;
+            uint32_t childCount = 0;
+            std::string name;
+            Tag tag;
+            LayerIndex layer;
+            Flags<GameObjectFlags> flags;
+            bool activeSelf = true;
+            Vector3f localPosition;
+            Quaternion localRotation;
+            Vector3f localScale;
+            uint32_t firstComponent = 0;
+            uint32_t componentCount = 0;
+        };
+
+        /** \brief Either a serializer payload or, when entry is null, an index into mFactories. */
+        struct ComponentTemplate {
+            const ComponentSerializers::Entry* entry;
+            uint32_t payloadOffset;
+            uint32_t payloadSize;
+            uint32_t factory = InvalidIndex;
+            uint32_t firstMaterial = 0;
+            uint32_t materialCount = 0;
+        };
+
+        struct CaptureType {
+            std::function<ComponentFactory(const Component&)> capture;
+            ComponentSerializers::ReserveFunc reserve;
+        };
+
+        static std::unordered_map<const Rtti*, CaptureType>& CaptureTypes();
+
+        static ComponentFactory CaptureRigidBody(const RigidBody& _rigidBody);
+
+        /** \brief Append a node, nodes have to be added in pre-order. */
+        uint32_t addNode(uint32_t _parent, const std::string& _name, const Tag& _tag, LayerIndex _layer, Flags<GameObjectFlags> _flags,
+                         const Vector3f& _position, const Quaternion& _rotation, const Vector3f& _scale);
+
+        /** \brief Append a Component to the last added node, _entry writes its payload. */
+        void addComponent(const ComponentSerializers::Entry& _entry, const std::function<void(ScenePayloadWriter&)>& _write);
+
+        /** \brief Append a Component without serializer to the last added node. */
+        void addComponent(ComponentFactory _factory, ComponentSerializers::ReserveFunc _reserve);
+
+        void countComponent(ComponentSerializers::ReserveFunc _reserve);
+
+        uint32_t resourceIndex(const std::shared_ptr<ResourceBase>& _resource);
+
+        std::string mName;
+        std::vector<Node> mNodes;
+        std::vector<ComponentTemplate> mComponents;
+        std::vector<uint8_t> mPayload;
+        std::vector<std::shared_ptr<ResourceBase>> mResources;
+        std::vector<ComponentFactory> mFactories;
+
+        /** \brief Materials of the captured Renderers, Materials aren't resources so they can't be payloads. */
+        std::vector<std::shared_ptr<Material>> mMaterials;
+
+        /** \brief Components of each pool in one instance, used to reserve the pools. */
+        std::vector<std::pair<ComponentSerializers::ReserveFunc, uint32_t>> mComponentCounts;
+    };
+
+    template<typename _Ty>
+    void Prefab::RegisterType(std::function<ComponentFactory(const _Ty&)> _capture) {
+        static_assert(std::is_base_of_v<Component, _Ty>, "Only Components can be captured");
+
+        auto capture = [capture = std::move(_capture)](const Component& _component) {
+            return capture(static_cast<const _Ty&>(_component));
+        };
+        auto reserve = [](uint32_t _count) { ComponentPool<_Ty>::Get().reserve(_count); };
+        CaptureTypes()[&_Ty::GetType()] = CaptureType{ std::move(capture), reserve };
+    }
+
+    template<typename _Ty>
+    void Prefab::RegisterType() {
+        RegisterType<_Ty>([](const _Ty&) -> ComponentFactory {
+            return [](GameObject& _object) { _object.addComponent<_Ty>(); };
+        });
+    }
+}
+
+#endif
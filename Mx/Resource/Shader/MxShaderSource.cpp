@@ -0,0 +1,5 @@
+#include "MxShaderSource.h"
+
+namespace Mix {
+	MX_IMPLEMENT_RTTI(ShaderSource, ResourceBase);
+}
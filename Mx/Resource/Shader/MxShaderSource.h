@@ -7,6 +7,7 @@
 
 namespace Mix {
 	class ShaderSource : public ResourceBase {
+		MX_DECLARE_RTTI;
 		friend class ShaderParser;
 	public:
 		ShaderSource(const std::vector<uint32_t>& _data,
@@ -1,21 +1,57 @@
 #include "MxRtti.hpp"
+#include <vector>
 
 namespace Mix {
+    // Constant initialized, so they are valid before any Rtti is constructed during dynamic initialization
+    uint32_t Rtti::sCount = 0;
+    Rtti* Rtti::sRegisteredHead = nullptr;
+    bool Rtti::sFinalized = false;
 
-    bool Rtti::isDerivedFrom(const Rtti* _type) const {
-        const Rtti* pTemp = this;
+    void Rtti::Finalize() {
+        constexpr uint32_t none = ~0u;
 
-        if (pTemp->isSameType(_type))
-            return false;
+        // Build the inheritance tree as first-child / next-sibling lists indexed by id
+        std::vector<Rtti*> types(sCount, nullptr);
+        std::vector<uint32_t> firstChild(sCount, none);
+        std::vector<uint32_t> nextSibling(sCount, none);
+        std::vector<uint32_t> roots;
 
-        while (!pTemp->isSameType(_type)) {
-            if (pTemp->mpBase) {
-                pTemp = pTemp->mpBase;
+        for (Rtti* type = sRegisteredHead; type; type = type->mpNextRegistered)
+            types[type->mId] = type;
+
+        for (Rtti* type : types) {
+            if (!type)
+                continue;
+            if (type->mpBase) {
+                nextSibling[type->mId] = firstChild[type->mpBase->mId];
+                firstChild[type->mpBase->mId] = type->mId;
             }
-            else {
-                return false;
+            else
+                roots.push_back(type->mId);
+        }
+
+        // Iterative DFS, a descendant's interval is strictly nested in its ancestors' intervals
+        uint32_t counter = 0;
+        std::vector<std::pair<uint32_t, uint32_t>> stack; // (id, next child to visit)
+        for (uint32_t root : roots) {
+            types[root]->mPre = counter++;
+            stack.emplace_back(root, firstChild[root]);
+
+            while (!stack.empty()) {
+                auto& top = stack.back();
+                const uint32_t child = top.second;
+                if (child == none) {
+                    types[top.first]->mPost = counter++;
+                    stack.pop_back();
+                    continue;
+                }
+
+                top.second = nextSibling[child];
+                types[child]->mPre = counter++;
+                stack.emplace_back(child, firstChild[child]);
             }
         }
-        return true;
+
+        sFinalized = true;
     }
 }
@@ -3,12 +3,20 @@
 #ifndef MX_RTTI_HPP_
 #define MX_RTTI_HPP_
 
+#include <cstdint>
 #include <string>
 #include <utility>
 
 namespace Mix {
     class Object;
 
+    /**
+     *  @brief Runtime type information of a class.
+     *
+     *  Every Rtti is numbered with a pre/post-order interval over the inheritance tree in Finalize(),
+     *  so isDerivedFrom() is two integer compares instead of a walk up the base chain. Finalize() runs
+     *  lazily on the first query after a new Rtti was created and explicitly at engine start up.
+     */
     class Rtti {
     public:
         /**
@@ -18,7 +26,11 @@ namespace Mix {
          */
         Rtti(std::string _rttiName, const Rtti* _pBase) :
             mRttiName(std::move(_rttiName)),
-            mpBase(_pBase) {
+            mpBase(_pBase),
+            mId(sCount++),
+            mpNextRegistered(sRegisteredHead) {
+            sRegisteredHead = this;
+            sFinalized = false;
         }
 
         ~Rtti() = default;
@@ -48,16 +60,50 @@ namespace Mix {
          */
         bool isDerivedFrom(const Rtti& _type) const { return isDerivedFrom(&_type); }
 
-        bool isDerivedFrom(const Rtti* _type) const;
+        bool isDerivedFrom(const Rtti* _type) const {
+            if (!sFinalized)
+                Finalize();
+            return _type != nullptr && _type->mPre < mPre && mPost < _type->mPost;
+        }
+
+        /**
+         *  @brief Check if this class is the same as or derived from another
+         *  @param _type Rtti of another class
+         */
+        bool isA(const Rtti& _type) const { return isSameType(_type) || isDerivedFrom(&_type); }
+
+        /**
+         *  @brief Number every Rtti created so far with its pre/post-order interval in the inheritance tree.
+         *  @note  NOT thread-safe, call it once at start up before type queries can happen on several threads.
+         */
+        static void Finalize();
 
         /**
          *  @return Base class of this class, otherwise return nullptr.
          */
         const Rtti* getBase() const { return mpBase; }
 
+        /**
+         *  @return A dense index of this rtti in [0, Count()), suitable for indexing per-type tables.
+         */
+        uint32_t getId() const { return mId; }
+
+        /**
+         *  @return The amount of rtti instances created so far.
+         */
+        static uint32_t Count() { return sCount; }
+
     private:
         std::string mRttiName;
         const Rtti* mpBase;
+        uint32_t mId;
+        uint32_t mPre = 0;
+        uint32_t mPost = 0;
+        Rtti* mpNextRegistered;
+
+        static uint32_t sCount;
+        static Rtti* sRegisteredHead;
+        static bool sFinalized;
     };
 }
 
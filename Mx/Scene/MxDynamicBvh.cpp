@@ -0,0 +1,219 @@
+#include "MxDynamicBvh.h"
+#include <algorithm>
+
+namespace Mix {
+    DynamicBvh::ProxyId DynamicBvh::insert(const AABB& _bounds, void* _userData) {
+        const uint32_t leaf = allocateNode();
+        Node& node = mNodes[leaf];
+        node.bounds = AABB(_bounds).expand(mMargin);
+        node.userData = _userData;
+        node.height = 0;
+
+        insertLeaf(leaf);
+        ++mProxyCount;
+        return leaf;
+    }
+
+    void DynamicBvh::remove(ProxyId _proxy) {
+        removeLeaf(_proxy);
+        freeNode(_proxy);
+        --mProxyCount;
+    }
+
+    bool DynamicBvh::update(ProxyId _proxy, const AABB& _bounds) {
+        // Also reinsert when the fat bounds became much larger than the object, e.g. after it shrank
+        const AABB& fat = mNodes[_proxy].bounds;
+        if (fat.contains(_bounds) && AABB(_bounds).expand(mMargin * 4.0f).contains(fat))
+            return false;
+
+        removeLeaf(_proxy);
+        mNodes[_proxy].bounds = AABB(_bounds).expand(mMargin);
+        insertLeaf(_proxy);
+        return true;
+    }
+
+    void DynamicBvh::clear() {
+        mNodes.clear();
+        mRoot = InvalidNode;
+        mFreeList = InvalidNode;
+        mProxyCount = 0;
+    }
+
+    uint32_t DynamicBvh::allocateNode() {
+        if (mFreeList == InvalidNode) {
+            mNodes.emplace_back();
+            return static_cast<uint32_t>(mNodes.size() - 1);
+        }
+
+        const uint32_t node = mFreeList;
+        mFreeList = mNodes[node].parent;
+        mNodes[node] = Node();
+        return node;
+    }
+
+    void DynamicBvh::freeNode(uint32_t _node) {
+        Node& node = mNodes[_node];
+        node.userData = nullptr;
+        node.child1 = node.child2 = InvalidNode;
+        node.height = -1;
+        node.parent = mFreeList;
+        mFreeList = _node;
+    }
+
+    void DynamicBvh::insertLeaf(uint32_t _leaf) {
+        if (mRoot == InvalidNode) {
+            mRoot = _leaf;
+            mNodes[_leaf].parent = InvalidNode;
+            return;
+        }
+
+        // Descend towards the sibling that minimizes the surface area heuristic
+        const AABB leafBounds = mNodes[_leaf].bounds;
+        uint32_t index = mRoot;
+        while (!mNodes[index].isLeaf()) {
+            const Node& node = mNodes[index];
+            const float area = node.bounds.surfaceArea();
+            const float combinedArea = AABB::Merge(node.bounds, leafBounds).surfaceArea();
+
+            // Cost of making a new parent of this node and the leaf, and the cost pushed down to the children
+            const float cost = 2.0f * combinedArea;
+            const float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto childCost = [&](uint32_t _child) {
+                const Node& child = mNodes[_child];
+                const float merged = AABB::Merge(child.bounds, leafBounds).surfaceArea();
+                return (child.isLeaf() ? merged : merged - child.bounds.surfaceArea()) + inheritanceCost;
+            };
+            const float cost1 = childCost(node.child1);
+            const float cost2 = childCost(node.child2);
+
+            if (cost < cost1 && cost < cost2)
+                break;
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        const uint32_t sibling = index;
+        const uint32_t oldParent = mNodes[sibling].parent;
+        const uint32_t newParent = allocateNode();
+
+        Node& parent = mNodes[newParent];
+        parent.parent = oldParent;
+        parent.bounds = AABB::Merge(leafBounds, mNodes[sibling].bounds);
+        parent.height = mNodes[sibling].height + 1;
+        parent.child1 = sibling;
+        parent.child2 = _leaf;
+
+        if (oldParent != InvalidNode)
+            replaceChild(oldParent, sibling, newParent);
+        else
+            mRoot = newParent;
+
+        mNodes[sibling].parent = newParent;
+        mNodes[_leaf].parent = newParent;
+
+        refitAncestors(mNodes[_leaf].parent);
+    }
+
+    void DynamicBvh::removeLeaf(uint32_t _leaf) {
+        if (_leaf == mRoot) {
+            mRoot = InvalidNode;
+            return;
+        }
+
+        // The sibling takes the place of the parent
+        const uint32_t parent = mNodes[_leaf].parent;
+        const uint32_t grandParent = mNodes[parent].parent;
+        const uint32_t sibling = mNodes[parent].child1 == _leaf ? mNodes[parent].child2 : mNodes[parent].child1;
+
+        mNodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        if (grandParent != InvalidNode) {
+            replaceChild(grandParent, parent, sibling);
+            refitAncestors(grandParent);
+        }
+        else {
+            mRoot = sibling;
+        }
+    }
+
+    void DynamicBvh::refitAncestors(uint32_t _node) {
+        uint32_t index = _node;
+        while (index != InvalidNode) {
+            index = balance(index);
+
+            Node& node = mNodes[index];
+            const Node& child1 = mNodes[node.child1];
+            const Node& child2 = mNodes[node.child2];
+            node.bounds = AABB::Merge(child1.bounds, child2.bounds);
+            node.height = 1 + std::max(child1.height, child2.height);
+
+            index = node.parent;
+        }
+    }
+
+    uint32_t DynamicBvh::balance(uint32_t _node) {
+        Node& a = mNodes[_node];
+        if (a.isLeaf() || a.height < 2)
+            return _node;
+
+        const uint32_t iB = a.child1;
+        const uint32_t iC = a.child2;
+        Node& b = mNodes[iB];
+        Node& c = mNodes[iC];
+        const int32_t balance = c.height - b.height;
+
+        // Rotate the taller child up, a takes the shorter of its children
+        auto rotateUp = [&](uint32_t _iUp, Node& _up, Node& _other, bool _upIsChild2) {
+            const uint32_t iF = _up.child1;
+            const uint32_t iG = _up.child2;
+            Node& f = mNodes[iF];
+            Node& g = mNodes[iG];
+
+            _up.child1 = _node;
+            _up.parent = a.parent;
+            a.parent = _iUp;
+
+            if (_up.parent != InvalidNode)
+                replaceChild(_up.parent, _node, _iUp);
+            else
+                mRoot = _iUp;
+
+            const bool keepF = f.height > g.height;
+            const uint32_t iKept = keepF ? iF : iG;
+            const uint32_t iGiven = keepF ? iG : iF;
+            Node& kept = keepF ? f : g;
+            Node& given = keepF ? g : f;
+
+            _up.child2 = iKept;
+            if (_upIsChild2)
+                a.child2 = iGiven;
+            else
+                a.child1 = iGiven;
+            given.parent = _node;
+
+            a.bounds = AABB::Merge(_other.bounds, given.bounds);
+            a.height = 1 + std::max(_other.height, given.height);
+            _up.bounds = AABB::Merge(a.bounds, kept.bounds);
+            _up.height = 1 + std::max(a.height, kept.height);
+        };
+
+        if (balance > 1) {
+            rotateUp(iC, c, b, true);
+            return iC;
+        }
+        if (balance < -1) {
+            rotateUp(iB, b, c, false);
+            return iB;
+        }
+        return _node;
+    }
+
+    void DynamicBvh::replaceChild(uint32_t _parent, uint32_t _oldChild, uint32_t _newChild) {
+        Node& parent = mNodes[_parent];
+        if (parent.child1 == _oldChild)
+            parent.child1 = _newChild;
+        else
+            parent.child2 = _newChild;
+    }
+}
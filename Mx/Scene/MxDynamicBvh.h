@@ -0,0 +1,157 @@
+#pragma once
+#ifndef MX_DYNAMIC_BVH_H_
+#define MX_DYNAMIC_BVH_H_
+
+#include "../Math/MxAABB.h"
+#include "../Math/MxFrustum.h"
+#include "../Math/MxRay.h"
+#include <vector>
+
+namespace Mix {
+    /**
+     * \brief Dynamic AABB tree, every leaf is a proxy holding the bounds of one object.
+     *
+     *        Leaves store bounds fattened by a margin, so an object moving inside them doesn't touch the tree.
+     *        A leaf is inserted next to the sibling that grows the total surface area the least and the tree is
+     *        kept balanced by rotations. Queries report the user data of every leaf whose fat bounds pass the
+     *        test, callers do the exact test if they need one.
+     *
+     * \note  Queries are const and may run concurrently, modifications may not.
+     */
+    class DynamicBvh {
+    public:
+        using ProxyId = uint32_t;
+
+        static constexpr ProxyId InvalidProxy = ~0u;
+
+        explicit DynamicBvh(const float _margin = 0.1f) :mMargin(_margin) {}
+
+        ProxyId insert(const AABB& _bounds, void* _userData);
+
+        void remove(ProxyId _proxy);
+
+        /**
+         * \brief Move a proxy to new bounds.
+         * \return true if the proxy was reinserted, false if the fat bounds still enclose _bounds.
+         */
+        bool update(ProxyId _proxy, const AABB& _bounds);
+
+        void clear();
+
+        void* getUserData(ProxyId _proxy) const { return mNodes[_proxy].userData; }
+
+        const AABB& getFatBounds(ProxyId _proxy) const { return mNodes[_proxy].bounds; }
+
+        uint32_t proxyCount() const { return mProxyCount; }
+
+        /** \brief Get the height of the tree, 0 for a single leaf. */
+        int32_t getHeight() const { return mRoot != InvalidNode ? mNodes[mRoot].height : 0; }
+
+        /** \brief Call _func(void* userData) for every proxy overlapping _box. */
+        template<typename _Func>
+        void query(const AABB& _box, _Func&& _func) const {
+            traverse([&_box](const AABB& _bounds) { return _bounds.intersects(_box); }, _func);
+        }
+
+        /** \brief Call _func(void* userData) for every proxy intersecting _frustum. */
+        template<typename _Func>
+        void query(const Frustum& _frustum, _Func&& _func) const {
+            traverse([&_frustum](const AABB& _bounds) { return _frustum.intersects(_bounds); }, _func);
+        }
+
+        /** \brief Call _func(void* userData) for every proxy overlapping the sphere. */
+        template<typename _Func>
+        void query(const Vector3f& _center, const float _radius, _Func&& _func) const {
+            traverse([&_center, _radius](const AABB& _bounds) { return _bounds.intersects(_center, _radius); }, _func);
+        }
+
+        /**
+         * \brief Call _func(void* userData, float distance) for every proxy hit by _ray within _maxDistance.
+         *        The distance is the one at which the ray enters the fat bounds, proxies are not sorted.
+         */
+        template<typename _Func>
+        void raycast(const Ray& _ray, const float _maxDistance, _Func&& _func) const;
+
+    private:
+        static constexpr uint32_t InvalidNode = ~0u;
+
+        /** \brief The tree is balanced, its height stays far below this for any proxy count. */
+        static constexpr uint32_t MaxStackSize = 128;
+
+        struct Node {
+            AABB bounds;
+            void* userData = nullptr;
+
+            /** \brief Parent of a node in the tree, next free node of a node in the free list. */
+            uint32_t parent = InvalidNode;
+            uint32_t child1 = InvalidNode;
+            uint32_t child2 = InvalidNode;
+
+            /** \brief 0 for a leaf, -1 for a free node. */
+            int32_t height = -1;
+
+            bool isLeaf() const { return child1 == InvalidNode; }
+        };
+
+        template<typename _Test, typename _Func>
+        void traverse(_Test&& _test, _Func&& _func) const;
+
+        uint32_t allocateNode();
+
+        void freeNode(uint32_t _node);
+
+        void insertLeaf(uint32_t _leaf);
+
+        void removeLeaf(uint32_t _leaf);
+
+        /** \brief Recompute the bounds and heights from _node up to the root, balancing on the way. */
+        void refitAncestors(uint32_t _node);
+
+        /** \brief Rotate the subtree at _node if it is unbalanced. \return The node now at its place. */
+        uint32_t balance(uint32_t _node);
+
+        void replaceChild(uint32_t _parent, uint32_t _oldChild, uint32_t _newChild);
+
+        std::vector<Node> mNodes;
+        uint32_t mRoot = InvalidNode;
+        uint32_t mFreeList = InvalidNode;
+        uint32_t mProxyCount = 0;
+        float mMargin;
+    };
+
+    template<typename _Test, typename _Func>
+    void DynamicBvh::traverse(_Test&& _test, _Func&& _func) const {
+        if (mRoot == InvalidNode)
+            return;
+
+        uint32_t stack[MaxStackSize];
+        uint32_t size = 0;
+        stack[size++] = mRoot;
+
+        while (size > 0) {
+            const Node& node = mNodes[stack[--size]];
+            if (!_test(node.bounds))
+                continue;
+
+            if (node.isLeaf()) {
+                _func(node.userData);
+            }
+            else {
+                stack[size++] = node.child1;
+                stack[size++] = node.child2;
+            }
+        }
+    }
+
+    template<typename _Func>
+    void DynamicBvh::raycast(const Ray& _ray, const float _maxDistance, _Func&& _func) const {
+        const Vector3f invDirection(1.0f / _ray.direction.x, 1.0f / _ray.direction.y, 1.0f / _ray.direction.z);
+
+        // A leaf is reported right after its own test, distance is still the one of that test
+        float distance = 0.0f;
+        traverse([&](const AABB& _bounds) { return _bounds.intersectsRay(_ray.origin, invDirection, _maxDistance, distance); },
+                 [&](void* _userData) { _func(_userData, distance); });
+    }
+}
+
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+
+#ifndef MX_GAME_OBJECT_INDEX_H_
+#define MX_GAME_OBJECT_INDEX_H_
+
+#include "../GameObject/MxGameObject.h"
+#include <unordered_map>
+#include <vector>
+
+namespace Mix {
+    /**
+     * \brief Hash index from a key (name, Tag, LayerIndex) to the GameObjects holding that key.
+     *
+     *        Each GameObject remembers its position inside its bucket through the member _Position,
+     *        so insertion and removal are O(1) amortized. Buckets are never freed, objects that are
+     *        renamed back and forth don't allocate.
+     */
+    template<typename _Key, uint32_t GameObject::* _Position>
+    class GameObjectIndex {
+    public:
+        static constexpr uint32_t InvalidPosition = ~0u;
+
+        using Bucket = std::vector<HGameObject>;
+
+        void insert(const _Key& _key, GameObject& _object) {
+            if (_object.*_Position != InvalidPosition)
+                return;
+
+            auto& bucket = mBuckets[_key];
+            _object.*_Position = static_cast<uint32_t>(bucket.size());
+            bucket.push_back(_object.getHandle());
+        }
+
+        void erase(const _Key& _key, GameObject& _object) {
+            const uint32_t position = _object.*_Position;
+            if (position == InvalidPosition)
+                return;
+
+            auto& bucket = mBuckets[_key];
+            bucket[position] = bucket.back();
+            // The object may already be marked as destroyed
+            static_cast<GameObject*>(bucket[position]._getPtr())->*_Position = position;
+            bucket.pop_back();
+            _object.*_Position = InvalidPosition;
+        }
+
+        /** \brief Get all GameObjects with _key, in no particular order. */
+        const Bucket& find(const _Key& _key) const {
+            static const Bucket empty;
+            auto it = mBuckets.find(_key);
+            return it != mBuckets.end() ? it->second : empty;
+        }
+
+    private:
+        std::unordered_map<_Key, Bucket> mBuckets;
+    };
+}
+
+#endif
@@ -3,7 +3,17 @@
 #include "../Log/MxLog.h"
 #include "../Component/Renderer/MxRenderer.h"
 #include "../Component/Camera/MxCamera.h"
+#include "../Component/MeshFilter/MxMeshFilter.h"
+#include "../Component/Transform/MxTransformSystem.h"
+#include "../Graphics/Mesh/MxMesh.h"
 #include "../Window/MxWindow.h"
+#include "../Thread/MxThreadPool.h"
+#include "../Time/MxTime.h"
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <numeric>
 
 namespace Mix {
     Scene::Scene(const std::string& _name, uint32_t _index)
@@ -17,17 +27,16 @@ namespace Mix {
     }
 
     HGameObject Scene::findGameObject(const std::string& _name, bool _wholeScene) {
-        /*for (auto& obj : mRootObjects) {
-            if (obj.second->getName() == _name)
-                return obj.second;
-            if (_wholeScene) {
-                auto child = obj.second->findChild(_name, true);
-                if (child != nullptr)
-                    return child;
-            }
+        for (auto& object : mNameIndex.find(_name)) {
+            if (_wholeScene || object->getParent() == nullptr)
+                return object;
         }
-        return nullptr;*/
-        return findGameObjectIf([&](const HGameObject& _gameObject)->bool {return _name == _gameObject->getName(); });
+        return nullptr;
+    }
+
+    HGameObject Scene::findGameObjectWithTag(const Tag& _tag) const {
+        auto& objects = mTagIndex.find(_tag);
+        return objects.empty() ? HGameObject() : objects.front();
     }
 
     void Scene::setFiller(const std::shared_ptr<SceneFiller>& _filler) {
@@ -70,42 +79,181 @@ namespace Mix {
     Scene::~Scene() {
         if (mIsLoaded)
             unload();
+
+        // Objects destroyed at the end of the frame may outlive the scene
+        for (auto behaviour : mBehaviours) {
+            behaviour->mScene = nullptr;
+            behaviour->mRegisteredIndex = Behaviour::InvalidListIndex;
+            for (auto& index : behaviour->mPhaseIndices)
+                index = Behaviour::InvalidListIndex;
+        }
+
+        for (auto renderer : mRenderers) {
+            renderer->mScene = nullptr;
+            renderer->mRenderIndex = Renderer::InvalidRenderIndex;
+            renderer->mBoundsProxy = Renderer::InvalidBoundsProxy;
+            renderer->mNextOnNode = nullptr;
+            renderer->mRenderElements.clear();
+            renderer->mRenderElementsDirty = false;
+        }
     }
 
     void Scene::sceneUpdate() {
-        /*for (auto& rootObject : mRootObjects) {
-            if (rootObject.second->activeSelf())
-                rootObject.second->update();
-        }*/
-        flushNewAddedBehaviour();
-        for (auto& behaviour : mBehaviours) {
-            if (behaviour.second->isEnabled() && behaviour.second->getGameObject()->activeInHierarchy())
-                behaviour.second->updateInternal();
-        }
+        runPhase(Behaviour::Phase_Update, &Behaviour::updateInternal);
     }
 
     void Scene::sceneFixedUpate() {
-        /*for (auto rootObject : mRootObjects)
-            if (rootObject.second->activeSelf())
-                rootObject.second->fixedUpdate();*/
-        flushNewAddedBehaviour();
-        for (auto& behaviour : mBehaviours) {
-            if (behaviour.second->isEnabled() && behaviour.second->getGameObject()->activeInHierarchy())
-                behaviour.second->fixedUpdateInternal();
-        }
+        runPhase(Behaviour::Phase_FixedUpdate, &Behaviour::fixedUpdateInternal);
     }
 
     void Scene::sceneLateUpate() {
-        /*for (auto& rootObject : mRootObjects)
-            if (rootObject.second->activeSelf())
-                rootObject.second->lateUpdate();*/
+        runPhase(Behaviour::Phase_LateUpdate, &Behaviour::lateUpdateInternal);
+    }
+
+    void Scene::runPhase(uint32_t _phase, void (Behaviour::* _hook)()) {
+        flushActivationChanges();
         flushNewAddedBehaviour();
-        for (auto& behaviour : mBehaviours) {
-            if (behaviour.second->isEnabled() && behaviour.second->getGameObject()->activeInHierarchy())
-                behaviour.second->lateUpdateInternal();
+
+        runParallelPhase(_phase, _hook);
+
+        auto& list = mPhaseLists[_phase];
+        mRunningPhase = static_cast<int>(_phase);
+
+        // Behaviours enabled during the pass are appended and still run in this pass
+        for (size_t i = 0; i < list.size(); ++i) {
+            Behaviour* behaviour = list[i];
+            if (!behaviour)
+                continue;
+
+            (behaviour->*_hook)();
+
+            // The default hook was called, the Behaviour doesn't need this phase
+            if (list[i] == behaviour && !behaviour->hasPhase(_phase))
+                removeFromPhase(behaviour, _phase);
+        }
+
+        mRunningPhase = -1;
+
+        if (mPhaseNeedsCompaction) {
+            size_t count = 0;
+            for (auto behaviour : list) {
+                if (behaviour) {
+                    behaviour->mPhaseIndices[_phase] = static_cast<uint32_t>(count);
+                    list[count++] = behaviour;
+                }
+            }
+            list.resize(count);
+            mPhaseNeedsCompaction = false;
         }
     }
 
+    void Scene::runParallelPhase(uint32_t _phase, void (Behaviour::* _hook)()) {
+        auto& parallel = mParallelPhases[_phase];
+        if (parallel.behaviours.empty())
+            return;
+
+        if (parallel.groupsDirty)
+            buildParallelGroups(_phase);
+
+        std::mutex exceptionMutex;
+        std::exception_ptr exception;
+
+        auto runGroups = [&](uint32_t _begin, uint32_t _end) {
+            for (uint32_t group = _begin; group < _end; ++group) {
+                for (uint32_t i = parallel.groupOffsets[group]; i < parallel.groupOffsets[group + 1]; ++i) {
+                    try {
+                        (parallel.behaviours[i]->*_hook)();
+                    }
+                    catch (...) {
+                        std::lock_guard<std::mutex> lock(exceptionMutex);
+                        if (!exception)
+                            exception = std::current_exception();
+                    }
+                }
+            }
+        };
+
+        // Behaviours of declared Component types may touch any GameObject, so they wait for the first stage
+        const uint32_t groupCount = static_cast<uint32_t>(parallel.groupOffsets.size()) - 1;
+        auto threadPool = ThreadPool::Get();
+        auto transformSystem = TransformSystem::Get();
+        transformSystem->_setParallelPhase(true);
+        threadPool->parallelFor(0, parallel.firstComponentGroup, ParallelGrainSize, runGroups);
+        threadPool->parallelFor(parallel.firstComponentGroup, groupCount, 1, runGroups);
+        transformSystem->_setParallelPhase(false);
+
+        // Drop Behaviours whose default hook was called, backwards so that swapped in ones were already checked
+        for (size_t i = parallel.behaviours.size(); i-- > 0;) {
+            Behaviour* behaviour = parallel.behaviours[i];
+            if (!behaviour->hasPhase(_phase))
+                removeFromPhase(behaviour, _phase);
+        }
+
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+    void Scene::buildParallelGroups(uint32_t _phase) {
+        auto& parallel = mParallelPhases[_phase];
+
+        // Union-find over Rtti ids, a declared type is joined with its bases below Component because
+        // Components of a derived type are also Components of the base type
+        mTypeRootScratch.resize(Rtti::Count());
+        std::iota(mTypeRootScratch.begin(), mTypeRootScratch.end(), 0u);
+        auto findRoot = [this](uint32_t _id) {
+            while (mTypeRootScratch[_id] != _id) {
+                mTypeRootScratch[_id] = mTypeRootScratch[mTypeRootScratch[_id]];
+                _id = mTypeRootScratch[_id];
+            }
+            return _id;
+        };
+
+        for (auto behaviour : parallel.behaviours) {
+            if (behaviour->mAccess != BehaviourAccess::DeclaredComponents || behaviour->mAccessTypes.empty())
+                continue;
+            const uint32_t first = behaviour->mAccessTypes.front()->getId();
+            for (auto declared : behaviour->mAccessTypes) {
+                for (const Rtti* type = declared; type && !type->isSameType(Component::GetType()); type = type->getBase())
+                    mTypeRootScratch[findRoot(type->getId())] = findRoot(first);
+            }
+        }
+
+        // Keys of the first stage fit in 33 bits, Component groups have the top bit set
+        constexpr uint64_t ComponentStageBit = uint64_t(1) << 63;
+        constexpr uint64_t UniqueGroupBit = uint64_t(1) << 32;
+
+        mGroupKeyScratch.clear();
+        for (auto behaviour : parallel.behaviours) {
+            uint64_t key;
+            if (behaviour->mAccess == BehaviourAccess::OwnGameObject)
+                key = static_cast<uint32_t>(behaviour->getGameObject().getInstanceId());
+            else if (behaviour->mAccessTypes.empty())
+                key = UniqueGroupBit | behaviour->mRegisteredIndex;
+            else
+                key = ComponentStageBit | findRoot(behaviour->mAccessTypes.front()->getId());
+            mGroupKeyScratch.emplace_back(key, behaviour);
+        }
+
+        std::stable_sort(mGroupKeyScratch.begin(), mGroupKeyScratch.end(), [](const auto& _a, const auto& _b) {
+            return _a.first < _b.first;
+        });
+
+        parallel.groupOffsets.clear();
+        parallel.firstComponentGroup = 0;
+        for (uint32_t i = 0; i < mGroupKeyScratch.size(); ++i) {
+            const uint64_t key = mGroupKeyScratch[i].first;
+            if (i == 0 || key != mGroupKeyScratch[i - 1].first) {
+                if ((key & ComponentStageBit) == 0)
+                    ++parallel.firstComponentGroup;
+                parallel.groupOffsets.push_back(i);
+            }
+            parallel.behaviours[i] = mGroupKeyScratch[i].second;
+            parallel.behaviours[i]->mPhaseIndices[_phase] = i;
+        }
+        parallel.groupOffsets.push_back(static_cast<uint32_t>(mGroupKeyScratch.size()));
+        parallel.groupsDirty = false;
+    }
+
     void Scene::scenePostRender() {
         // flushNewAddedBehaviour();
     }
@@ -113,11 +261,20 @@ namespace Mix {
     void Scene::activate() {
         mIsActive = true;
 
-        for (auto& behaviour : mNewBehaviours) {
-            mBehaviours[behaviour.getInstanceId()] = behaviour;
+        awakeNewBehaviours(std::numeric_limits<float>::infinity());
+        flushNewAddedBehaviour();
+    }
+
+    bool Scene::awakeNewBehaviours(float _deadline) {
+        while (mAwokenBehaviourCount < mNewBehaviours.size()) {
+            // awake() may register or unregister Behaviours, which adjusts the count
+            HBehaviour behaviour = mNewBehaviours[mAwokenBehaviourCount++];
             behaviour->awakeInternal();
+
+            if (Time::RealTime() >= _deadline)
+                return mAwokenBehaviourCount == mNewBehaviours.size();
         }
-        mNewBehaviours.clear();
+        return true;
     }
 
     std::vector<HGameObject> Scene::getRootGameObjects() const {
@@ -134,10 +291,17 @@ namespace Mix {
         if (_object->getParent() == nullptr) {
             mRootObjects[_object.getInstanceId()] = _object;
         }
+        indexGameObject(*_object);
 
         auto behaviours = _object->getComponents<Behaviour>();
         for (auto behaviour : behaviours)
             registerBehaviour(behaviour);
+
+        _object->forEachComponent<Renderer>([this](Renderer& _renderer) { registerRenderer(&_renderer); });
+
+        // A GameObject moved in from another scene may still have a change to notify
+        if (_object->mActiveInHierarchy != _object->mActiveNotified)
+            queueActivationChange(*_object);
     }
 
     void Scene::unregisterGameObject(const HGameObject& _object) {
@@ -146,30 +310,219 @@ namespace Mix {
             return;
         }
 
-        if (_object->getParent() == nullptr) {
-            mRootObjects.erase(mRootObjects.find(_object.get()->getInstanceId()));
-        }
+        // A child detached by GameObject::destroy() has no parent but was never a root
+        if (_object->getParent() == nullptr)
+            mRootObjects.erase(_object.getInstanceId());
+        unindexGameObject(*_object);
 
-        auto behaviours = _object->getComponents<Behaviour>();
-        for (auto behaviour : behaviours)
-            unregisterBehaviour(behaviour);
+        // Its entry in mActivationChanges is skipped by the next flush
+        _object->mActivationQueued = false;
+
+        _object->forEachComponent<Behaviour>([this](Behaviour& _behaviour) { unregisterBehaviour(&_behaviour); });
+
+        _object->forEachComponent<Renderer>([this](Renderer& _renderer) { unregisterRenderer(&_renderer); });
     }
 
     void Scene::registerBehaviour(const HBehaviour& _behaviour) {
         if (mIsActive)
             _behaviour->awakeInternal();
         mNewBehaviours.push_back(_behaviour);
+
+        // Every new Behaviour of an active scene has been awoken
+        if (mIsActive)
+            mAwokenBehaviourCount = static_cast<uint32_t>(mNewBehaviours.size());
     }
 
     void Scene::unregisterBehaviour(const HBehaviour& _behaviour) {
-        if (mIsActive) {
-            mBehaviours.erase(_behaviour.getInstanceId());
-        }
-        else {
-            auto it = std::find(mNewBehaviours.begin(), mNewBehaviours.end(), _behaviour);
-            if (it != mNewBehaviours.end())
+        // The Behaviour may already be marked as destroyed
+        if (auto ptr = _behaviour._getPtr())
+            unregisterBehaviour(static_cast<Behaviour*>(ptr));
+    }
+
+    void Scene::unregisterBehaviour(Behaviour* _behaviour) {
+        if (_behaviour->mScene != this) {
+            auto it = std::find_if(mNewBehaviours.begin(), mNewBehaviours.end(), [_behaviour](const HBehaviour& _h) {
+                return _h.getInstanceId() == _behaviour->getInstanceId();
+            });
+            if (it != mNewBehaviours.end()) {
+                if (static_cast<uint32_t>(it - mNewBehaviours.begin()) < mAwokenBehaviourCount)
+                    --mAwokenBehaviourCount;
                 mNewBehaviours.erase(it);
+            }
+            return;
+        }
+
+        removeFromPhaseLists(_behaviour);
+
+        const uint32_t index = _behaviour->mRegisteredIndex;
+        Behaviour* last = mBehaviours.back();
+        mBehaviours[index] = last;
+        last->mRegisteredIndex = index;
+        mBehaviours.pop_back();
+
+        _behaviour->mRegisteredIndex = Behaviour::InvalidListIndex;
+        _behaviour->mScene = nullptr;
+    }
+
+    void Scene::addToPhaseLists(Behaviour* _behaviour) {
+        for (uint32_t phase = 0; phase < Behaviour::Phase_Count; ++phase) {
+            if (!_behaviour->hasPhase(phase) || _behaviour->mPhaseIndices[phase] != Behaviour::InvalidListIndex)
+                continue;
+
+            if (_behaviour->isParallel(phase)) {
+                auto& parallel = mParallelPhases[phase];
+                _behaviour->mPhaseIndices[phase] = static_cast<uint32_t>(parallel.behaviours.size());
+                parallel.behaviours.push_back(_behaviour);
+                parallel.groupsDirty = true;
+            }
+            else {
+                _behaviour->mPhaseIndices[phase] = static_cast<uint32_t>(mPhaseLists[phase].size());
+                mPhaseLists[phase].push_back(_behaviour);
+            }
+        }
+    }
+
+    void Scene::removeFromPhaseLists(Behaviour* _behaviour) {
+        for (uint32_t phase = 0; phase < Behaviour::Phase_Count; ++phase)
+            removeFromPhase(_behaviour, phase);
+    }
+
+    void Scene::removeFromPhase(Behaviour* _behaviour, uint32_t _phase) {
+        if (_behaviour->mPhaseIndices[_phase] == Behaviour::InvalidListIndex)
+            return;
+
+        if (_behaviour->isParallel(_phase))
+            removeFromParallelList(_behaviour, _phase);
+        else
+            removeFromSerialList(_behaviour, _phase);
+    }
+
+    void Scene::removeFromSerialList(Behaviour* _behaviour, uint32_t _phase) {
+        const uint32_t index = _behaviour->mPhaseIndices[_phase];
+        _behaviour->mPhaseIndices[_phase] = Behaviour::InvalidListIndex;
+
+        auto& list = mPhaseLists[_phase];
+
+        // Keep the order stable while the phase is being iterated
+        if (mRunningPhase == static_cast<int>(_phase)) {
+            list[index] = nullptr;
+            mPhaseNeedsCompaction = true;
+            return;
+        }
+
+        Behaviour* last = list.back();
+        list[index] = last;
+        if (last)
+            last->mPhaseIndices[_phase] = index;
+        list.pop_back();
+    }
+
+    void Scene::removeFromParallelList(Behaviour* _behaviour, uint32_t _phase) {
+        const uint32_t index = _behaviour->mPhaseIndices[_phase];
+        _behaviour->mPhaseIndices[_phase] = Behaviour::InvalidListIndex;
+
+        // Parallel lists are never iterated while Behaviours may be removed, the groups are rebuilt lazily
+        auto& parallel = mParallelPhases[_phase];
+        Behaviour* last = parallel.behaviours.back();
+        parallel.behaviours[index] = last;
+        last->mPhaseIndices[_phase] = index;
+        parallel.behaviours.pop_back();
+        parallel.groupsDirty = true;
+    }
+
+    void Scene::onBehaviourStarted(Behaviour* _behaviour) {
+        // isParallel() only became true now, the Behaviour is still in the serial list of every listed phase
+        bool moved = false;
+        for (uint32_t phase = 0; phase < Behaviour::Phase_Count; ++phase) {
+            if (_behaviour->mPhaseIndices[phase] != Behaviour::InvalidListIndex && _behaviour->isParallel(phase)) {
+                removeFromSerialList(_behaviour, phase);
+                moved = true;
+            }
         }
+
+        if (moved)
+            addToPhaseLists(_behaviour);
+    }
+
+    void Scene::registerRenderer(Renderer* _renderer) {
+        if (_renderer->mScene == this)
+            return;
+
+        _renderer->mScene = this;
+        _renderer->mRenderIndex = static_cast<uint32_t>(mRenderers.size());
+        mRenderers.push_back(_renderer);
+        updateRenderer(_renderer);
+
+        const uint32_t node = _renderer->getGameObject()->transform()._getNode();
+        if (node >= mNodeRenderers.size())
+            mNodeRenderers.resize(node + 1, nullptr);
+        _renderer->mBoundsNode = node;
+        _renderer->mNextOnNode = mNodeRenderers[node];
+        mNodeRenderers[node] = _renderer;
+
+        // It may already be flagged if its Mesh or Materials changed while it was in no scene
+        _renderer->mRenderElementsDirty = true;
+        mDirtyRenderers.push_back(_renderer);
+    }
+
+    void Scene::unregisterRenderer(Renderer* _renderer) {
+        if (_renderer->mScene != this)
+            return;
+
+        // Leave the active range first, then swap with the last one
+        uint32_t index = _renderer->mRenderIndex;
+        if (index < mActiveRendererCount) {
+            const uint32_t lastActive = --mActiveRendererCount;
+            std::swap(mRenderers[index], mRenderers[lastActive]);
+            mRenderers[index]->mRenderIndex = index;
+            index = lastActive;
+        }
+
+        mRenderers[index] = mRenderers.back();
+        mRenderers[index]->mRenderIndex = index;
+        mRenderers.pop_back();
+
+        _renderer->mScene = nullptr;
+        _renderer->mRenderIndex = Renderer::InvalidRenderIndex;
+
+        // A GameObject rarely has more than one Renderer, the list is short
+        Renderer** link = &mNodeRenderers[_renderer->mBoundsNode];
+        while (*link != _renderer)
+            link = &(*link)->mNextOnNode;
+        *link = _renderer->mNextOnNode;
+        _renderer->mNextOnNode = nullptr;
+
+        if (_renderer->mRenderElementsDirty) {
+            mDirtyRenderers.erase(std::find(mDirtyRenderers.begin(), mDirtyRenderers.end(), _renderer));
+            _renderer->mRenderElementsDirty = false;
+        }
+        _renderer->mRenderElements.clear();
+
+        if (_renderer->mBoundsProxy != Renderer::InvalidBoundsProxy) {
+            mRendererBvh.remove(_renderer->mBoundsProxy);
+            _renderer->mBoundsProxy = Renderer::InvalidBoundsProxy;
+        }
+
+        // Static Renderers rarely leave the scene, a linear walk over the pieces is fine
+        if (_renderer->mStaticBatched) {
+            for (auto& batch : mStaticBatches)
+                batch.removeRenderer(_renderer);
+            _renderer->mStaticBatched = false;
+        }
+    }
+
+    void Scene::updateRenderer(Renderer* _renderer) {
+        const uint32_t index = _renderer->mRenderIndex;
+        const bool active = _renderer->isEnable() && _renderer->getGameObject()->activeInHierarchy();
+        const bool inActiveRange = index < mActiveRendererCount;
+        if (active == inActiveRange)
+            return;
+
+        // The boundary element trades places with _renderer
+        const uint32_t boundary = active ? mActiveRendererCount++ : --mActiveRendererCount;
+        std::swap(mRenderers[index], mRenderers[boundary]);
+        mRenderers[index]->mRenderIndex = index;
+        mRenderers[boundary]->mRenderIndex = boundary;
     }
 
     void Scene::rootGameObjectChanged(const HGameObject& _object) {
@@ -179,12 +532,31 @@ namespace Mix {
             mRootObjects.erase(_object.getInstanceId());
     }
 
+    void Scene::indexGameObject(GameObject& _object) {
+        mNameIndex.insert(_object.getName(), _object);
+        mTagIndex.insert(_object.getTag(), _object);
+        mLayerIndex.insert(_object.getLayer(), _object);
+    }
+
+    void Scene::unindexGameObject(GameObject& _object) {
+        mNameIndex.erase(_object.getName(), _object);
+        mTagIndex.erase(_object.getTag(), _object);
+        mLayerIndex.erase(_object.getLayer(), _object);
+    }
+
     void Scene::flushNewAddedBehaviour() {
         if (!mNewBehaviours.empty()) {
-            for (auto& behaviour : mNewBehaviours) {
-                mBehaviours[behaviour.getInstanceId()] = behaviour;
+            for (auto& handle : mNewBehaviours) {
+                Behaviour* behaviour = handle.operator->();
+                behaviour->mScene = this;
+                behaviour->mRegisteredIndex = static_cast<uint32_t>(mBehaviours.size());
+                mBehaviours.push_back(behaviour);
+
+                if (behaviour->isEnabled() && behaviour->getGameObject()->activeInHierarchy())
+                    addToPhaseLists(behaviour);
             }
             mNewBehaviours.clear();
+            mAwokenBehaviourCount = 0;
         }
 
         /*for (auto& needAwakeObj : mNeedAwakeAndInit) {
@@ -202,23 +574,66 @@ namespace Mix {
         mNeedAwakeAndInit.clear();*/
     }
 
-    void Scene::load() {
-        if (mIsLoaded)
-            MX_EXCEPT("Attempting to load a Scene twice.");
+    void Scene::queueActivationChange(GameObject& _object) {
+        if (_object.mActivationQueued)
+            return;
+        _object.mActivationQueued = true;
+        mActivationChanges.push_back(_object.mThisHandle);
+    }
+
+    void Scene::flushActivationChanges() {
+        // Callbacks may change the activation of other objects, those are queued for the next flush
+        while (!mActivationChanges.empty()) {
+            mActivationScratch.swap(mActivationChanges);
 
-        if (mFiller == nullptr) {
-            MX_LOG_WARNING("Scene [%1%] has no specified SceneFiller. Use DefaultSceneFiller instead.", mName);
+            for (auto& handle : mActivationScratch) {
+                if (handle.isDestroyed())
+                    continue;
 
-            SceneFiller* filler = new DefaultSceneFiller();
-            filler->fill(mThisPtr.lock());
-            delete filler;
+                GameObject& object = *handle;
+                if (!object.mActivationQueued || object.mScene.get() != this)
+                    continue;
+                object.mActivationQueued = false;
+
+                if (object.mActiveInHierarchy == object.mActiveNotified)
+                    continue;
+                object.mActiveNotified = object.mActiveInHierarchy;
+
+                object.forEachComponent<Renderer>([this](Renderer& _renderer) { updateRenderer(&_renderer); });
+
+                if (object.mActiveInHierarchy)
+                    object.forEachComponent<Behaviour>([](Behaviour& _behaviour) { _behaviour.onEnableInternal(); });
+                else
+                    object.forEachComponent<Behaviour>([](Behaviour& _behaviour) { _behaviour.onDisableInternal(); });
+            }
+            mActivationScratch.clear();
         }
-        else
-            mFiller->fill(mThisPtr.lock());
+    }
+
+    void Scene::load() {
+        if (mIsLoaded || mIsLoading)
+            MX_EXCEPT("Attempting to load a Scene twice.");
+
+        getLoadFiller()->fill(mThisPtr.lock());
+        buildStaticBatches();
         mIsLoaded = true;
     }
 
+    std::shared_ptr<SceneFiller> Scene::getLoadFiller() {
+        if (mFiller)
+            return mFiller;
+
+        MX_LOG_WARNING("Scene [%1%] has no specified SceneFiller. Use DefaultSceneFiller instead.", mName);
+        return std::make_shared<DefaultSceneFiller>();
+    }
+
     void Scene::unload() {
+        if (mIsLoading) {
+            MX_LOG_WARNING("Scene [%1%] is being loaded asynchronously and can't be unloaded yet.", mName);
+            return;
+        }
+
+        clearStaticBatches();
         for (auto& gameObject : mRootObjects) {
             if (!gameObject.second.isDestroyed())
                 gameObject.second->destroy();
@@ -226,28 +641,122 @@ namespace Mix {
         mIsLoaded = false;
     }
 
+    void Scene::buildStaticBatches() {
+        clearStaticBatches();
+        mStaticBatches = StaticBatch::Build(mRenderers.data(), static_cast<uint32_t>(mRenderers.size()));
+    }
+
+    void Scene::clearStaticBatches() {
+        for (auto& batch : mStaticBatches)
+            batch.release();
+        mStaticBatches.clear();
+    }
+
+    void Scene::updateRendererBounds() {
+        // Renderers that got a Mesh were inserted by updateRenderElements(), only moved ones are left
+        auto& updatedNodes = TransformSystem::Get()->getUpdatedNodes();
+        for (auto node : updatedNodes) {
+            if (node >= mNodeRenderers.size())
+                continue;
+            for (Renderer* renderer = mNodeRenderers[node]; renderer; renderer = renderer->mNextOnNode)
+                refreshRendererBounds(renderer);
+        }
+    }
+
+    void Scene::refreshRendererBounds(Renderer* _renderer) {
+        AABB bounds;
+        if (!GetRendererBounds(*_renderer, bounds))
+            return;
+
+        if (_renderer->mBoundsProxy != Renderer::InvalidBoundsProxy)
+            mRendererBvh.update(_renderer->mBoundsProxy, bounds);
+        else
+            _renderer->mBoundsProxy = mRendererBvh.insert(bounds, _renderer);
+    }
+
+    void Scene::updateRenderElements() {
+        for (auto renderer : mDirtyRenderers) {
+            renderer->mRenderElementsDirty = false;
+            auto& elements = renderer->mRenderElements;
+            elements.clear();
+
+            auto filter = renderer->getGameObject()->getComponent<MeshFilter>();
+            auto mesh = filter ? filter->getMesh() : nullptr;
+            if (!mesh)
+                continue;
+
+            // A new Mesh has new bounds, and a Renderer that just got one isn't in the tree yet
+            refreshRendererBounds(renderer);
+
+            const HTransform transform = renderer->transform();
+            auto& materials = renderer->getMaterials();
+            const uint32_t count = std::min(mesh->subMeshCount(), static_cast<uint32_t>(materials.size()));
+            elements.reserve(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                RenderElement element;
+                element.transform = transform;
+                element.mesh = mesh;
+                element.material = materials[i];
+                element.submesh = i;
+                elements.push_back(std::move(element));
+            }
+        }
+        mDirtyRenderers.clear();
+    }
+
+    bool Scene::GetRendererBounds(const Renderer& _renderer, AABB& _bounds) {
+        auto object = _renderer.getGameObject();
+        auto filter = object->getComponent<MeshFilter>();
+        auto mesh = filter ? filter->getMesh() : nullptr;
+        if (!mesh)
+            return false;
+
+        _bounds = mesh->getBounds().transformed(object->transform().cachedLocalToWorldMatrix());
+        return true;
+    }
+
+    auto Scene::activeRendererCollector(std::vector<Renderer*>& _result) const {
+        return [this, &_result](void* _userData) {
+            auto renderer = static_cast<Renderer*>(_userData);
+            if (renderer->mRenderIndex < mActiveRendererCount)
+                _result.push_back(renderer);
+        };
+    }
+
+    void Scene::queryRenderers(const Frustum& _frustum, std::vector<Renderer*>& _result) const {
+        mRendererBvh.query(_frustum, activeRendererCollector(_result));
+    }
+
+    void Scene::queryRenderers(const AABB& _box, std::vector<Renderer*>& _result) const {
+        mRendererBvh.query(_box, activeRendererCollector(_result));
+    }
+
+    void Scene::queryRenderers(const Vector3f& _center, const float _radius, std::vector<Renderer*>& _result) const {
+        mRendererBvh.query(_center, _radius, activeRendererCollector(_result));
+    }
+
+    void Scene::raycastRenderers(const Ray& _ray, const float _maxDistance, std::vector<std::pair<Renderer*, float>>& _result) const {
+        mRendererBvh.raycast(_ray, _maxDistance, [this, &_result](void* _userData, float _distance) {
+            auto renderer = static_cast<Renderer*>(_userData);
+            if (renderer->mRenderIndex < mActiveRendererCount)
+                _result.emplace_back(renderer, _distance);
+        });
+    }
+
     SceneRenderInfo Scene::_getRendererInfoPerFrame() {
         SceneRenderInfo info;
 
         // Set camera
         info.camera = mMainCamera.get().get();
 
-        // Get all enabled Renderer
-        for (auto& gameObject : mRootObjects) {
-            FindRendererRecur(info, gameObject.second);
-        }
-
-        return info;
-    }
+        // The active range is kept up to date by add, remove, enable and setActive
+        info.renderers = mRenderers.data();
+        info.rendererCount = mActiveRendererCount;
 
-    void Scene::FindRendererRecur(SceneRenderInfo& _info, const HGameObject& _object) {
-        auto renderer = _object->getComponent<Renderer>();
-        if (renderer != nullptr && renderer->getGameObject()->activeInHierarchy())
-            _info.renderers.push_back(renderer.get().get());
+        info.staticBatches = mStaticBatches.data();
+        info.staticBatchCount = static_cast<uint32_t>(mStaticBatches.size());
 
-        for (auto& child : _object->getAllChildren()) {
-            FindRendererRecur(_info, child);
-        }
+        return info;
     }
 
     HGameObject SceneFiller::createGameObject(const std::string& _name, const Tag& _tag, const LayerIndex _layerIndex, Flags<GameObjectFlags> _flags) const {
@@ -261,6 +770,13 @@ namespace Mix {
         mTemp.reset();
     }
 
+    bool SceneFiller::fillStep(const std::shared_ptr<Scene>& _scene, float _deadline) {
+        mTemp = _scene;
+        const bool done = fillSceneStep(mTemp, _deadline);
+        mTemp.reset();
+        return done;
+    }
+
     void DefaultSceneFiller::fillScene(const std::shared_ptr<Scene>& _scene) {
         HGameObject gameObject = createGameObject("MainCamera");
         auto camera = gameObject->addComponent<Camera>(Window::Get()->getExtent());
@@ -9,6 +9,9 @@
 
 #include "../GameObject/MxGameObject.h"
 #include "../Graphics/MxRenderInfo.h"
+#include "../Graphics/MxStaticBatch.h"
+#include "MxDynamicBvh.h"
+#include "MxGameObjectIndex.h"
 
 namespace Mix {
     class SceneFiller;
@@ -17,6 +20,9 @@ namespace Mix {
         friend class SceneManager;
         friend class GameObject;
         friend class SceneFiller;
+        friend class Behaviour;
+        friend class Renderer;
+        friend class SceneLoadOperation;
     public:
         const std::string& getName() const { return mName; }
 
@@ -30,6 +36,27 @@ namespace Mix {
          */
         HGameObject findGameObject(const std::string& _name, bool _wholeScene = false);
 
+        /**
+         * \brief Get all GameObjects in the scene with the specified name, in no particular order.
+         * \note  The reference is invalidated when a GameObject is added, removed or renamed.
+         */
+        const std::vector<HGameObject>& findGameObjectsWithName(const std::string& _name) const { return mNameIndex.find(_name); }
+
+        /** \brief Get any GameObject in the scene with the specified Tag, or null handle if no one found. */
+        HGameObject findGameObjectWithTag(const Tag& _tag) const;
+
+        /**
+         * \brief Get all GameObjects in the scene with the specified Tag, in no particular order.
+         * \note  The reference is invalidated when a GameObject is added, removed or retagged.
+         */
+        const std::vector<HGameObject>& findGameObjectsWithTag(const Tag& _tag) const { return mTagIndex.find(_tag); }
+
+        /**
+         * \brief Get all GameObjects in the scene in the specified Layer, in no particular order.
+         * \note  The reference is invalidated when a GameObject is added, removed or moved to another Layer.
+         */
+        const std::vector<HGameObject>& findGameObjectsInLayer(LayerIndex _layer) const { return mLayerIndex.find(_layer); }
+
         /** \brief Set a filler for this scene. */
         void setFiller(const std::shared_ptr<SceneFiller>& _filler);
 
@@ -48,24 +75,54 @@ namespace Mix {
         /** \brief Get the main camera of the scene. */
         HCamera getMainCamera();
 
+        /** \brief Check if _camera was set as the main camera, without falling back to the first registered one. */
+        bool isMainCamera(const HCamera& _camera) const { return mMainCamera == _camera; }
+
         /** \brief Check if the scene is currently active. */
         bool isActive() const { return mIsActive; }
 
         /** \brief Check if the scene has been loaded. */
         bool isLoaded() const { return mIsLoaded; }
 
+        /** \brief Check if the scene is being loaded asynchronously. */
+        bool isLoading() const { return mIsLoading; }
+
         /** \brief Get all root GameObjects in the scene. */
         std::vector<HGameObject> getRootGameObjects() const;
 
         SceneRenderInfo _getRendererInfoPerFrame();
 
+        /**
+         * \brief Merge the Renderers of GameObjects flagged IsStatic into StaticBatches, replacing the previous ones.
+         *        Called once the scene is filled, call it again after static content was added or changed.
+         */
+        void buildStaticBatches();
+
+        const std::vector<StaticBatch>& getStaticBatches() const { return mStaticBatches; }
+
+        /**
+         * \brief Append to _result the enabled Renderers active in hierarchy whose bounds may intersect _frustum.
+         * \note  The bounds are fattened and refreshed once per frame, after the transforms were updated.
+         */
+        void queryRenderers(const Frustum& _frustum, std::vector<Renderer*>& _result) const;
+
+        void queryRenderers(const AABB& _box, std::vector<Renderer*>& _result) const;
+
+        void queryRenderers(const Vector3f& _center, const float _radius, std::vector<Renderer*>& _result) const;
+
+        /** \brief Append to _result every Renderer hit by _ray, with the distance at which the ray enters its bounds. */
+        void raycastRenderers(const Ray& _ray, const float _maxDistance, std::vector<std::pair<Renderer*, float>>& _result) const;
+
+        /** \brief Spatial index of the Renderers, the user data of a proxy is its Renderer. */
+        const DynamicBvh& getRendererBvh() const { return mRendererBvh; }
+
         uint32_t getIndex() const { return mIndex; }
 
         /**
          *\brief Return the first found gameobject that satisfies the specified condition.
          *\param _pred A callable object that defines the condition to be satisfied by the element.
          *\note  This may be expensive when the amount of gameobjects in the scene is too big.\n
-         *       Avoid calling this as possible as you can.
+         *       Avoid calling this as possible as you can, prefer the name, tag and layer lookups.
          */
         template<typename _Pr>
         HGameObject findGameObjectIf(_Pr _pred) const;
@@ -112,11 +169,66 @@ namespace Mix {
 
         void unregisterBehaviour(const HBehaviour& _behaviour);
 
+        void unregisterBehaviour(Behaviour* _behaviour);
+
+        /** \brief Add a registered Behaviour to the list of every phase it overrides. */
+        void addToPhaseLists(Behaviour* _behaviour);
+
+        void removeFromPhaseLists(Behaviour* _behaviour);
+
+        void removeFromPhase(Behaviour* _behaviour, uint32_t _phase);
+
+        void removeFromSerialList(Behaviour* _behaviour, uint32_t _phase);
+
+        void removeFromParallelList(Behaviour* _behaviour, uint32_t _phase);
+
+        /** \brief Move a Behaviour whose start() just returned from the serial lists to the parallel ones it declared. */
+        void onBehaviourStarted(Behaviour* _behaviour);
+
+        /** \brief Call _hook on every Behaviour in the list of _phase. */
+        void runPhase(uint32_t _phase, void (Behaviour::*_hook)());
+
+        /** \brief Call _hook on the Behaviours of _phase that declared their access, using the ThreadPool. */
+        void runParallelPhase(uint32_t _phase, void (Behaviour::*_hook)());
+
+        /** \brief Sort the parallel list of _phase into groups that are safe to run concurrently. */
+        void buildParallelGroups(uint32_t _phase);
+
+        void registerRenderer(Renderer* _renderer);
+
+        void unregisterRenderer(Renderer* _renderer);
+
+        /** \brief Move a registered Renderer in or out of the active range after its enabled or active state changed. */
+        void updateRenderer(Renderer* _renderer);
+
         void rootGameObjectChanged(const HGameObject& _object);
 
+        /** \brief Remember that activeInHierarchy() of _object changed, its Components are notified by the next flush. */
+        void queueActivationChange(GameObject& _object);
+
+        /**
+         * \brief Notify the Behaviours and Renderers of every queued GameObject whose state still differs from
+         *        the one they were last notified of. Toggling an object back and forth in between costs nothing.
+         */
+        void flushActivationChanges();
+
+        /** \brief Add a GameObject to the name, tag and layer indexes. */
+        void indexGameObject(GameObject& _object);
+
+        void unindexGameObject(GameObject& _object);
+
         /** \brief Flush all GameObjects registered in the scene but not yet added to the scene */
         void flushNewAddedBehaviour();
 
+        /**
+         * \brief Call awake() of the new Behaviours that haven't been awoken yet, until Time::RealTime() passes _deadline.
+         * \return True once every new Behaviour has been awoken.
+         */
+        bool awakeNewBehaviours(float _deadline);
+
+        /** \brief Get the filler used to load the scene, DefaultSceneFiller if none was set. */
+        std::shared_ptr<SceneFiller> getLoadFiller();
+
         /** \brief Set the index of the scene */
         void setIndex(uint32_t _index) { mIndex = _index; }
 
@@ -128,15 +240,95 @@ namespace Mix {
         void unload();
 
     private:
-        static void FindRendererRecur(SceneRenderInfo& _info, const HGameObject& _object);
-
 
         std::weak_ptr<Scene> mThisPtr;
         std::string mName;
         std::unordered_map<uint64_t, HGameObject> mRootObjects;
-        std::map<uint64_t, HBehaviour> mBehaviours;
+
+        // Every GameObject in the scene, whatever its depth in the hierarchy
+        GameObjectIndex<std::string, &GameObject::mNameIndexPosition> mNameIndex;
+        GameObjectIndex<Tag, &GameObject::mTagIndexPosition> mTagIndex;
+        GameObjectIndex<LayerIndex, &GameObject::mLayerIndexPosition> mLayerIndex;
         std::vector<HBehaviour> mNewBehaviours;
 
+        /** \brief The leading mNewBehaviours that were already awoken. */
+        uint32_t mAwokenBehaviourCount = 0;
+
+        /** \brief Every Behaviour registered to the scene, each one knows its own index. */
+        std::vector<Behaviour*> mBehaviours;
+
+        /**
+         * \brief Enabled and active Behaviours overriding the hook of each phase. Behaviours removed while
+         *        their phase is running leave a nullptr which is compacted at the end of the pass.
+         */
+        std::vector<Behaviour*> mPhaseLists[Behaviour::Phase_Count];
+        int mRunningPhase = -1;
+        bool mPhaseNeedsCompaction = false;
+
+        /**
+         * \brief Behaviours of a phase whose hook may run on worker threads.
+         *
+         *        The list is sorted into groups, Behaviours of one group run serially and groups run in parallel.
+         *        Groups of Behaviours restricted to their own GameObject run first, then the groups of declared
+         *        Component types, since the latter may touch any GameObject. Both stages run before the serial
+         *        list of the phase.
+         */
+        struct ParallelPhase {
+            std::vector<Behaviour*> behaviours;
+            /** \brief Group g is [groupOffsets[g], groupOffsets[g + 1]). */
+            std::vector<uint32_t> groupOffsets;
+            uint32_t firstComponentGroup = 0;
+            bool groupsDirty = false;
+        };
+
+        ParallelPhase mParallelPhases[Behaviour::Phase_Count];
+
+        /** \brief GameObject groups per parallel task. */
+        static constexpr uint32_t ParallelGrainSize = 32;
+
+        // Scratch buffers reused by buildParallelGroups()
+        std::vector<std::pair<uint64_t, Behaviour*>> mGroupKeyScratch;
+        std::vector<uint32_t> mTypeRootScratch;
+
+        /**
+         * \brief Every Renderer registered to the scene, each one knows its own index. Renderers that are
+         *        enabled and whose GameObject is active in hierarchy are kept in [0, mActiveRendererCount).
+         */
+        std::vector<Renderer*> mRenderers;
+        uint32_t mActiveRendererCount = 0;
+
+        std::vector<StaticBatch> mStaticBatches;
+
+        /** \brief Release the StaticBatches, their Renderers are drawn on their own again. */
+        void clearStaticBatches();
+
+        /** \brief Renderers whose render elements are rebuilt by the next updateRenderElements(). */
+        std::vector<Renderer*> mDirtyRenderers;
+
+        /** \brief Rebuild the render elements and the bounds of the dirty Renderers from their Mesh and Materials. */
+        void updateRenderElements();
+
+        DynamicBvh mRendererBvh;
+
+        /** \brief GameObjects whose activeInHierarchy() changed since the last flush, in the order they changed. */
+        std::vector<HGameObject> mActivationChanges;
+        std::vector<HGameObject> mActivationScratch;
+
+        /** \brief First Renderer of this scene on each transform node, indexed by NodeId, linked by mNextOnNode. */
+        std::vector<Renderer*> mNodeRenderers;
+
+        /** \brief Refit the Renderers whose transform node was recomputed by this frame's TransformSystem::update(). */
+        void updateRendererBounds();
+
+        /** \brief Insert the bounds of _renderer into the tree or refit them, nothing happens if it has no Mesh. */
+        void refreshRendererBounds(Renderer* _renderer);
+
+        /** \brief World space bounds of the Mesh of _renderer, false if it has none. */
+        static bool GetRendererBounds(const Renderer& _renderer, AABB& _bounds);
+
+        /** \brief Get a query callback appending the Renderers of the active range to _result. */
+        auto activeRendererCollector(std::vector<Renderer*>& _result) const;
+
         std::vector<HCamera> mRegisteredCamera;
         HCamera mMainCamera;
 
@@ -144,6 +336,7 @@ namespace Mix {
         bool mIsActive = false;
 
         bool mIsLoaded = false;
+        bool mIsLoading = false;
         std::shared_ptr<SceneFiller> mFiller;
 
     };
@@ -166,8 +359,7 @@ namespace Mix {
                 return obj;
             }
 
-            auto children = obj->getAllChildren();
-            for (auto child : children) {
+            for (auto& child : obj->mChildren) {
                 queue.push(child);
             }
         }
@@ -181,6 +373,7 @@ namespace Mix {
      */
     class SceneFiller {
         friend class Scene;
+        friend class SceneManager;
     public:
         virtual ~SceneFiller() = default;
 
@@ -191,9 +384,29 @@ namespace Mix {
 
         virtual void fillScene(const std::shared_ptr<Scene>& _scene) = 0;
 
+        /**
+         * \brief Called on a worker thread before the first fillSceneStep() when the scene is loaded asynchronously.
+         *        Do file I/O here. Must not touch the scene, GameObjects or GPU resources.
+         */
+        virtual void prepareAsync() {}
+
+        /**
+         * \brief Fill part of the scene when it is loaded asynchronously. Called once per frame until it returns true,
+         *        work should stop once Time::RealTime() passes _deadline. The default fills the whole scene at once.
+         */
+        virtual bool fillSceneStep(const std::shared_ptr<Scene>& _scene, float _deadline) {
+            fillScene(_scene);
+            return true;
+        }
+
+        /** \brief Get how much of the scene has been filled by fillSceneStep(), in [0, 1]. */
+        virtual float getFillProgress() const { return 0.0f; }
+
     private:
         void fill(const std::shared_ptr<Scene>& _scene);
 
+        bool fillStep(const std::shared_ptr<Scene>& _scene, float _deadline);
+
         std::shared_ptr<Scene> mTemp;
     };
 
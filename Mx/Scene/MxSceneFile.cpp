@@ -0,0 +1,214 @@
+#include "MxSceneFile.h"
+#include "MxSceneSerializer.h"
+#include "../Resource/MxResourceLoader.h"
+#include "../Resource/Model/MxModel.h"
+#include "../Log/MxLog.h"
+#include "../Time/MxTime.h"
+#include "../Utils/MxUtils.h"
+#include <algorithm>
+#include <fstream>
+#include <unordered_set>
+
+namespace Mix {
+    bool SceneFile::open(const std::filesystem::path& _path) {
+        if (!mFile.open(_path))
+            return false;
+
+        auto fits = [this](uint32_t _offset, uint64_t _size, uint32_t _alignment) {
+            return _offset % _alignment == 0 && _offset + _size <= mFile.size();
+        };
+
+        bool valid = mFile.size() >= sizeof(SceneFormat::Header);
+        if (valid) {
+            const auto& header = getHeader();
+            valid = header.magic == SceneFormat::Magic &&
+                header.version == SceneFormat::Version &&
+                fits(header.objectOffset, uint64_t(header.objectCount) * sizeof(SceneFormat::ObjectRecord), SceneFormat::TableAlignment) &&
+                fits(header.componentOffset, uint64_t(header.componentCount) * sizeof(SceneFormat::ComponentRecord), SceneFormat::TableAlignment) &&
+                fits(header.resourceOffset, uint64_t(header.resourceCount) * sizeof(SceneFormat::ResourceRecord), SceneFormat::TableAlignment) &&
+                fits(header.stringsOffset, header.stringsSize, 1) &&
+                fits(header.payloadOffset, header.payloadSize, 1);
+        }
+
+        if (!valid)
+            mFile.close();
+        return valid;
+    }
+
+    std::string_view SceneFile::getString(const SceneFormat::StringRef& _ref) const {
+        const auto& header = getHeader();
+        if (uint64_t(_ref.offset) + _ref.length > header.stringsSize)
+            return {};
+        return std::string_view(reinterpret_cast<const char*>(mFile.data() + header.stringsOffset + _ref.offset), _ref.length);
+    }
+
+    const uint8_t* SceneFile::getPayload(const SceneFormat::ComponentRecord& _record) const {
+        const auto& header = getHeader();
+        if (uint64_t(_record.payloadOffset) + _record.payloadSize > header.payloadSize)
+            return nullptr;
+        return mFile.data() + header.payloadOffset + _record.payloadOffset;
+    }
+
+    SceneFileLoader::SceneFileLoader(std::shared_ptr<SceneFile> _file) :mFile(std::move(_file)) {
+        mResources.resize(mFile->resourceCount());
+        mObjects.resize(mFile->objectCount());
+    }
+
+    bool SceneFileLoader::loadResources(uint32_t _maxCount) {
+        const uint32_t end = mNextResource + std::min(_maxCount, mFile->resourceCount() - mNextResource);
+        for (; mNextResource < end; ++mNextResource) {
+            const uint32_t i = mNextResource;
+            const auto& record = mFile->getResource(i);
+            const auto path = mFile->getString(record.path);
+            if (path.empty())
+                continue;
+
+            auto it = mFiles.find(path);
+            if (it == mFiles.end())
+                it = mFiles.emplace(path, ResourceLoader::Get()->load(std::string(path))).first;
+            if (!it->second)
+                continue;
+
+            if (record.subIndex < 0)
+                mResources[i] = it->second;
+            else if (auto model = rtti_pointer_cast<Model>(it->second); model && static_cast<size_t>(record.subIndex) < model->meshCount())
+                mResources[i] = model->getMeshes()[record.subIndex];
+            else
+                MX_LOG_WARNING("[%1%] has no sub resource %2%.", std::string(path), record.subIndex);
+        }
+        return mNextResource == mFile->resourceCount();
+    }
+
+    bool SceneFileLoader::instantiate(const std::shared_ptr<Scene>& _scene, uint32_t _maxObjects) {
+        const uint32_t end = mNextObject + std::min(_maxObjects, objectCount() - mNextObject);
+        for (; mNextObject < end; ++mNextObject)
+            instantiateObject(_scene, mNextObject);
+        return mNextObject == objectCount();
+    }
+
+    void SceneFileLoader::instantiateObject(const std::shared_ptr<Scene>& _scene, uint32_t _index) {
+        const auto& record = mFile->getObject(_index);
+
+        HGameObject parent;
+        if (record.parent != SceneFormat::InvalidIndex) {
+            if (record.parent >= _index)
+                MX_EXCEPT("Corrupted scene file, a parent must precede its children.");
+            parent = mObjects[record.parent];
+        }
+
+        auto object = GameObject::CreateInHierarchy(_scene,
+                                                    parent,
+                                                    std::string(mFile->getString(record.name)),
+                                                    std::string(mFile->getString(record.tag)),
+                                                    record.layer,
+                                                    Flags<GameObjectFlags>(record.flags));
+
+        Transform& transform = object->transform();
+        transform.setLocalPosition(Vector3f(record.localPosition[0], record.localPosition[1], record.localPosition[2]));
+        transform.setLocalRotation(Quaternion(record.localRotation[3], record.localRotation[0], record.localRotation[1], record.localRotation[2]));
+        transform.setLocalScale(Vector3f(record.localScale[0], record.localScale[1], record.localScale[2]));
+
+        if (uint64_t(record.firstComponent) + record.componentCount > mFile->componentCount())
+            MX_EXCEPT("Corrupted scene file, component range out of bounds.");
+
+        for (uint32_t i = record.firstComponent; i < record.firstComponent + record.componentCount; ++i) {
+            const auto& componentRecord = mFile->getComponent(i);
+            auto entry = ComponentSerializers::Get().find(componentRecord.typeHash);
+            if (!entry) {
+                MX_LOG_WARNING("GameObject [%1%] has a Component of unknown type, it is skipped.", object->getName());
+                continue;
+            }
+
+            auto payload = mFile->getPayload(componentRecord);
+            if (!payload)
+                MX_EXCEPT("Corrupted scene file, component payload out of bounds.");
+
+            ScenePayloadReader reader(payload, componentRecord.payloadSize, mResources);
+            entry->create(*object, reader);
+        }
+
+        if (!record.activeSelf)
+            object->setActive(false);
+
+        mObjects[_index] = object;
+    }
+
+    bool BinarySceneFiller::openFile() {
+        if (mLoader)
+            return true;
+
+        auto file = std::make_shared<SceneFile>();
+        if (!file->open(mPath)) {
+            MX_LOG_ERROR("Failed to open scene file [%1%].", mPath.string());
+            return false;
+        }
+
+        mFile = file;
+        mLoader = std::make_unique<SceneFileLoader>(file);
+        return true;
+    }
+
+    void BinarySceneFiller::fillScene(const std::shared_ptr<Scene>& _scene) {
+        if (!openFile())
+            return;
+
+        mLoader->loadResources();
+        mLoader->instantiate(_scene);
+        mLoader.reset();
+        mFile.reset();
+    }
+
+    void BinarySceneFiller::prepareAsync() {
+        if (!openFile())
+            return;
+
+        // Fault every page of the mapping in here rather than during instantiation
+        const auto& header = mFile->getHeader();
+        const uint32_t end = header.payloadOffset + header.payloadSize;
+        const volatile uint8_t* bytes = reinterpret_cast<const uint8_t*>(&header);
+        for (uint32_t offset = 0; offset < end; offset += 4096)
+            (void)bytes[offset];
+
+        // Read the resource files once, parsing them on the main thread then hits the OS file cache
+        std::vector<char> buffer(1 << 16);
+        std::unordered_set<std::string_view> visited;
+        for (uint32_t i = 0; i < mFile->resourceCount(); ++i) {
+            const auto path = mFile->getString(mFile->getResource(i).path);
+            if (path.empty() || !visited.insert(path).second)
+                continue;
+
+            std::ifstream stream(Utils::GetGenericPath(std::string(path)), std::ios::binary);
+            while (stream.read(buffer.data(), buffer.size()))
+                ;
+        }
+    }
+
+    bool BinarySceneFiller::fillSceneStep(const std::shared_ptr<Scene>& _scene, float _deadline) {
+        if (!openFile())
+            return true;
+
+        // One resource at a time, a single parse can take longer than the whole budget
+        while (!mLoader->loadResources(1)) {
+            if (Time::RealTime() >= _deadline)
+                return false;
+        }
+
+        while (!mLoader->instantiate(_scene, ObjectsPerStep)) {
+            if (Time::RealTime() >= _deadline)
+                return false;
+        }
+
+        mLoader.reset();
+        mFile.reset();
+        return true;
+    }
+
+    float BinarySceneFiller::getFillProgress() const {
+        if (!mLoader)
+            return 0.0f;
+
+        const uint32_t total = mFile->resourceCount() + mFile->objectCount();
+        const uint32_t done = mLoader->loadedResourceCount() + mLoader->instantiatedCount();
+        return total == 0 ? 1.0f : static_cast<float>(done) / total;
+    }
+}
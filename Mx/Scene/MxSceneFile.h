@@ -0,0 +1,126 @@
+#pragma once
+#ifndef MX_SCENE_FILE_H_
+#define MX_SCENE_FILE_H_
+
+#include "MxScene.h"
+#include "MxSceneFormat.h"
+#include "../Utils/MxMappedFile.h"
+#include <string_view>
+#include <unordered_map>
+
+namespace Mix {
+    /**
+     * \brief A binary scene file mapped into memory. open() only validates the header and the table
+     *        bounds, records are read in place.
+     */
+    class SceneFile {
+    public:
+        /** \return False if the file can't be mapped or isn't a valid scene file. */
+        bool open(const std::filesystem::path& _path);
+
+        const SceneFormat::Header& getHeader() const { return *reinterpret_cast<const SceneFormat::Header*>(mFile.data()); }
+
+        uint32_t objectCount() const { return getHeader().objectCount; }
+
+        const SceneFormat::ObjectRecord& getObject(uint32_t _index) const { return table<SceneFormat::ObjectRecord>(getHeader().objectOffset)[_index]; }
+
+        uint32_t componentCount() const { return getHeader().componentCount; }
+
+        const SceneFormat::ComponentRecord& getComponent(uint32_t _index) const { return table<SceneFormat::ComponentRecord>(getHeader().componentOffset)[_index]; }
+
+        uint32_t resourceCount() const { return getHeader().resourceCount; }
+
+        const SceneFormat::ResourceRecord& getResource(uint32_t _index) const { return table<SceneFormat::ResourceRecord>(getHeader().resourceOffset)[_index]; }
+
+        /** \return The referenced string, empty if _ref lies outside the string blob. */
+        std::string_view getString(const SceneFormat::StringRef& _ref) const;
+
+        /** \return The payload bytes of a Component, nullptr if the record lies outside the payload blob. */
+        const uint8_t* getPayload(const SceneFormat::ComponentRecord& _record) const;
+
+    private:
+        template<typename _Ty>
+        const _Ty* table(uint32_t _offset) const { return reinterpret_cast<const _Ty*>(mFile.data() + _offset); }
+
+        MappedFile mFile;
+    };
+
+
+    /**
+     * \brief Instantiates the content of a SceneFile into a Scene.
+     *
+     *        Loading is split so that the work can be spread: loadResources() touches no scene state,
+     *        then instantiate() creates GameObjects in file order, in as many calls as wanted.
+     */
+    class SceneFileLoader {
+    public:
+        explicit SceneFileLoader(std::shared_ptr<SceneFile> _file);
+
+        /**
+         * \brief Load up to _maxCount more resources referenced by the file.
+         * \return True once every resource has been loaded.
+         */
+        bool loadResources(uint32_t _maxCount = ~0u);
+
+        uint32_t loadedResourceCount() const { return mNextResource; }
+
+        /**
+         * \brief Create up to _maxObjects more GameObjects with their Components in _scene.
+         * \return True once every GameObject of the file has been created.
+         */
+        bool instantiate(const std::shared_ptr<Scene>& _scene, uint32_t _maxObjects = ~0u);
+
+        uint32_t instantiatedCount() const { return mNextObject; }
+
+        uint32_t objectCount() const { return mFile->objectCount(); }
+
+        /** \brief Get the GameObject created for the record _index of the file. */
+        const HGameObject& getGameObject(uint32_t _index) const { return mObjects[_index]; }
+
+    private:
+        void instantiateObject(const std::shared_ptr<Scene>& _scene, uint32_t _index);
+
+        std::shared_ptr<SceneFile> mFile;
+        std::vector<std::shared_ptr<ResourceBase>> mResources;
+        std::vector<HGameObject> mObjects;
+        uint32_t mNextResource = 0;
+        uint32_t mNextObject = 0;
+
+        /** \brief Files loaded so far, several sub resources usually share one file. */
+        std::unordered_map<std::string_view, std::shared_ptr<ResourceBase>> mFiles;
+    };
+
+
+    /**
+     * \brief Fills a scene from a binary scene file written by SceneWriter.
+     *
+     *        When loaded asynchronously the file is mapped and paged in on a worker thread, together with
+     *        the files of the referenced resources. Resources are then parsed and GameObjects created on
+     *        the main thread, since parsers upload to the GPU.
+     */
+    class BinarySceneFiller :public SceneFiller {
+    public:
+        explicit BinarySceneFiller(std::filesystem::path _path) :mPath(std::move(_path)) {}
+
+    private:
+        void fillScene(const std::shared_ptr<Scene>& _scene) override;
+
+        void prepareAsync() override;
+
+        bool fillSceneStep(const std::shared_ptr<Scene>& _scene, float _deadline) override;
+
+        float getFillProgress() const override;
+
+        /** \brief Map the file and create the loader, return false if the file is invalid. */
+        bool openFile();
+
+        /** \brief GameObjects created between two deadline checks. */
+        static constexpr uint32_t ObjectsPerStep = 16;
+
+        std::filesystem::path mPath;
+        std::shared_ptr<SceneFile> mFile;
+        std::unique_ptr<SceneFileLoader> mLoader;
+    };
+}
+
+#endif
@@ -0,0 +1,93 @@
+#pragma once
+#ifndef MX_SCENE_FORMAT_H_
+#define MX_SCENE_FORMAT_H_
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Mix {
+    /**
+     * \brief On-disk layout of binary scene files (.mxscene).
+     *
+     *        A file is a Header followed by flat tables, every table starts at an 8-byte aligned offset:
+     *        - ObjectRecord per GameObject, in pre-order so a parent always precedes its children;
+     *        - ComponentRecord per Component, the records of one GameObject are contiguous;
+     *        - ResourceRecord per referenced resource;
+     *        - a string blob holding names, tags and resource paths (not null terminated);
+     *        - a payload blob holding the serialized data of each Component.
+     *
+     *        Records are read in place from a mapped file, all values are little endian.
+     */
+    namespace SceneFormat {
+        constexpr uint32_t Magic = 0x4353584D; // "MXSC"
+        constexpr uint32_t Version = 1;
+        constexpr uint32_t InvalidIndex = ~0u;
+        constexpr uint32_t TableAlignment = 8;
+
+        struct StringRef {
+            uint32_t offset;
+            uint32_t length;
+        };
+
+        struct Header {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t objectCount;
+            uint32_t objectOffset;
+            uint32_t componentCount;
+            uint32_t componentOffset;
+            uint32_t resourceCount;
+            uint32_t resourceOffset;
+            uint32_t stringsOffset;
+            uint32_t stringsSize;
+            uint32_t payloadOffset;
+            uint32_t payloadSize;
+        };
+
+        struct ObjectRecord {
+            /** \brief Index of the parent record, InvalidIndex for root GameObjects. */
+            uint32_t parent;
+            StringRef name;
+            StringRef tag;
+            uint32_t layer;
+            uint32_t flags;
+            uint32_t activeSelf;
+            uint32_t firstComponent;
+            uint32_t componentCount;
+            float localPosition[3];
+            float localRotation[4]; // x, y, z, w
+            float localScale[3];
+        };
+
+        struct ComponentRecord {
+            /** \brief FNV-1a hash of the Rtti name, stable across builds unlike Rtti ids. */
+            uint64_t typeHash;
+            uint32_t payloadOffset;
+            uint32_t payloadSize;
+        };
+
+        struct ResourceRecord {
+            StringRef path;
+            /** \brief Index of a sub resource (e.g. a Mesh of a Model), -1 for the file itself. */
+            int32_t subIndex;
+            uint32_t reserved;
+        };
+
+        static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) == 48, "Unexpected Header layout");
+        static_assert(std::is_trivially_copyable_v<ObjectRecord> && sizeof(ObjectRecord) == 84, "Unexpected ObjectRecord layout");
+        static_assert(std::is_trivially_copyable_v<ComponentRecord> && sizeof(ComponentRecord) == 16, "Unexpected ComponentRecord layout");
+        static_assert(std::is_trivially_copyable_v<ResourceRecord> && sizeof(ResourceRecord) == 16, "Unexpected ResourceRecord layout");
+
+        /** \brief FNV-1a, used for component type hashes. */
+        constexpr uint64_t HashName(const char* _name, size_t _length) {
+            uint64_t hash = 0xcbf29ce484222325ull;
+            for (size_t i = 0; i < _length; ++i) {
+                hash ^= static_cast<uint8_t>(_name[i]);
+                hash *= 0x100000001b3ull;
+            }
+            return hash;
+        }
+    }
+}
+
+#endif
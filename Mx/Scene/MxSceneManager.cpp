@@ -1,5 +1,8 @@
 #include "MxSceneManager.h"
+#include "../Thread/MxThreadPool.h"
+#include "../Time/MxTime.h"
 #include "../../MixEngine.h"
+#include <algorithm>
 
 namespace Mix {
 
@@ -51,6 +54,129 @@ namespace Mix {
             MX_LOG_WARNING("Attempting to load Scene by index with a wrong index.");
     }
 
+    float SceneLoadOperation::getProgress() const {
+        switch (mStage) {
+        case Stage::Preparing: return 0.0f;
+        case Stage::Filling:   return 0.1f + 0.8f * std::clamp(mFiller->getFillProgress(), 0.0f, 1.0f);
+        case Stage::Awaking: {
+            const auto& behaviours = mScene->mNewBehaviours;
+            return behaviours.empty() ? 1.0f : 0.9f + 0.1f * mScene->mAwokenBehaviourCount / behaviours.size();
+        }
+        default: return 1.0f;
+        }
+    }
+
+    std::shared_ptr<SceneLoadOperation> SceneManager::loadSceneAsync(const std::string& _name, bool _activate, SceneLoadOperation::LoadedCallback _onLoaded) {
+        auto scene = getScene(_name);
+        if (!scene) {
+            MX_LOG_WARNING("Attempting to load Scene named %1% that doesn't exist.", _name);
+            return nullptr;
+        }
+        return loadSceneAsync(scene, _activate, std::move(_onLoaded));
+    }
+
+    std::shared_ptr<SceneLoadOperation> SceneManager::loadSceneAsync(uint32_t _index, bool _activate, SceneLoadOperation::LoadedCallback _onLoaded) {
+        auto scene = getScene(_index);
+        if (!scene) {
+            MX_LOG_WARNING("Attempting to load Scene by index with a wrong index.");
+            return nullptr;
+        }
+        return loadSceneAsync(scene, _activate, std::move(_onLoaded));
+    }
+
+    std::shared_ptr<SceneLoadOperation> SceneManager::loadSceneAsync(const std::shared_ptr<Scene>& _scene, bool _activate, SceneLoadOperation::LoadedCallback _onLoaded) {
+        if (_scene->mIsLoaded || _scene->mIsLoading)
+            MX_EXCEPT("Attempting to load a Scene twice.");
+
+        auto operation = std::make_shared<SceneLoadOperation>();
+        operation->mScene = _scene;
+        operation->mFiller = _scene->getLoadFiller();
+        operation->mActivate = _activate;
+        operation->mOnLoaded = std::move(_onLoaded);
+        _scene->mIsLoading = true;
+
+        // The job keeps the filler alive on its own
+        auto prepare = [operation] {
+            try {
+                operation->mFiller->prepareAsync();
+            }
+            catch (...) {
+                operation->mPrepareException = std::current_exception();
+            }
+            operation->mPrepared.store(true, std::memory_order_release);
+        };
+
+        // Without workers nothing would ever pick the job up, prepare on the calling thread instead
+        auto threadPool = ThreadPool::Get();
+        if (threadPool->threadCount() == 0)
+            prepare();
+        else
+            threadPool->schedule(std::move(prepare));
+
+        mAsyncLoads.push_back(operation);
+        return operation;
+    }
+
+    void SceneManager::updateAsyncLoads() {
+        if (mAsyncLoads.empty())
+            return;
+
+        const float deadline = Time::RealTime() + mAsyncLoadBudget / 1000.0f;
+        while (!mAsyncLoads.empty() && Time::RealTime() < deadline) {
+            auto operation = mAsyncLoads.front();
+            bool done;
+            try {
+                done = stepAsyncLoad(*operation, deadline);
+            }
+            catch (...) {
+                mAsyncLoads.pop_front();
+                operation->mScene->mIsLoading = false;
+                throw;
+            }
+            if (!done)
+                break;
+            // Pop first, the callback may start another load
+            mAsyncLoads.pop_front();
+
+            if (operation->mActivate)
+                setActiveScene(operation->mScene);
+            if (operation->mOnLoaded)
+                operation->mOnLoaded(operation->mScene);
+        }
+    }
+
+    bool SceneManager::stepAsyncLoad(SceneLoadOperation& _operation, float _deadline) {
+        auto& scene = _operation.mScene;
+
+        switch (_operation.mStage) {
+        case SceneLoadOperation::Stage::Preparing:
+            if (!_operation.mPrepared.load(std::memory_order_acquire))
+                return false;
+            if (_operation.mPrepareException)
+                std::rethrow_exception(_operation.mPrepareException);
+            _operation.mStage = SceneLoadOperation::Stage::Filling;
+            [[fallthrough]];
+
+        case SceneLoadOperation::Stage::Filling:
+            if (!_operation.mFiller->fillStep(scene, _deadline))
+                return false;
+            scene->buildStaticBatches();
+            _operation.mStage = SceneLoadOperation::Stage::Awaking;
+            [[fallthrough]];
+
+        case SceneLoadOperation::Stage::Awaking:
+            if (!scene->awakeNewBehaviours(_deadline))
+                return false;
+            scene->mIsLoading = false;
+            scene->mIsLoaded = true;
+            _operation.mStage = SceneLoadOperation::Stage::Done;
+            [[fallthrough]];
+
+        default:
+            return true;
+        }
+    }
+
     void SceneManager::setActiveScene(const std::shared_ptr<Scene>& _scene) {
         _scene->activate();
         if (mActiveScene)
@@ -109,6 +235,12 @@ namespace Mix {
         mActiveScene->scenePostRender();
     }
 
+    void SceneManager::updateSceneBounds() {
+        mActiveScene->flushActivationChanges();
+        mActiveScene->updateRenderElements();
+        mActiveScene->updateRendererBounds();
+    }
+
     void SceneManager::registerGameObjectToMS(const HGameObject& _object) {
         mActiveScene->registerGameObject(_object);
     }
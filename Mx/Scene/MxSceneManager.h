@@ -5,6 +5,9 @@
 
 #include "MxScene.h"
 #include "../Engine/MxModuleBase.h"
+#include <atomic>
+#include <deque>
+#include <exception>
 
 namespace Mix {
     //class SceneManager final : public ModuleBase {
@@ -36,6 +39,43 @@ namespace Mix {
     //};
 
 
+    /**
+     * \brief Tracks a scene being loaded by SceneManager::loadSceneAsync().
+     */
+    class SceneLoadOperation {
+        friend class SceneManager;
+    public:
+        using LoadedCallback = std::function<void(const std::shared_ptr<Scene>&)>;
+
+        const std::shared_ptr<Scene>& getScene() const { return mScene; }
+
+        /** \brief Get the progress of the load in [0, 1]. */
+        float getProgress() const;
+
+        /** \brief Check if the scene has finished loading, the callback has been called by then. */
+        bool isDone() const { return mStage == Stage::Done; }
+
+    private:
+        enum class Stage {
+            Preparing,
+            Filling,
+            Awaking,
+            Done
+        };
+
+        std::shared_ptr<Scene> mScene;
+        std::shared_ptr<SceneFiller> mFiller;
+        bool mActivate = true;
+        LoadedCallback mOnLoaded;
+
+        Stage mStage = Stage::Preparing;
+
+        // Written by the thread running SceneFiller::prepareAsync()
+        std::atomic<bool> mPrepared{ false };
+        std::exception_ptr mPrepareException;
+    };
+
+
     class SceneManager final :public ModuleBase {
     public:
         static SceneManager* Get();
@@ -54,6 +94,25 @@ namespace Mix {
 
         void loadScene(uint32_t _index);
 
+        /**
+         * \brief Load a scene over several frames while the active scene keeps running.
+         *
+         *        SceneFiller::prepareAsync() runs on the ThreadPool, or right away on the calling thread if the
+         *        pool has no worker. Then the filler and the awake() of new Behaviours run on the main thread
+         *        within the per-frame budget, see setAsyncLoadBudget().
+         *        Several loads are processed one after another.
+         * \param _activate Make the scene active once it is loaded.
+         * \param _onLoaded Called once the scene is loaded, after it was activated.
+         */
+        std::shared_ptr<SceneLoadOperation> loadSceneAsync(const std::string& _name, bool _activate = true, SceneLoadOperation::LoadedCallback _onLoaded = nullptr);
+
+        std::shared_ptr<SceneLoadOperation> loadSceneAsync(uint32_t _index, bool _activate = true, SceneLoadOperation::LoadedCallback _onLoaded = nullptr);
+
+        /** \brief Set the main thread time spent on asynchronous loads per frame, in milliseconds. */
+        void setAsyncLoadBudget(float _milliseconds) { mAsyncLoadBudget = _milliseconds; }
+
+        float getAsyncLoadBudget() const { return mAsyncLoadBudget; }
+
         void setActiveScene(const std::shared_ptr<Scene>& _scene);
 
         void unloadScene(const std::string& _name);
@@ -80,9 +139,23 @@ namespace Mix {
 
         void scenePostRender();
 
+        /**
+         * \brief Notify pending activation changes, rebuild the render elements that changed and refit the
+         *        spatial index of the active scene, called once the transforms of the frame are updated.
+         */
+        void updateSceneBounds();
+
+        /** \brief Advance asynchronous loads, called once per frame after rendering. */
+        void updateAsyncLoads();
+
     private:
         friend GameObject;
 
+        std::shared_ptr<SceneLoadOperation> loadSceneAsync(const std::shared_ptr<Scene>& _scene, bool _activate, SceneLoadOperation::LoadedCallback _onLoaded);
+
+        /** \brief Advance _operation until _deadline, return true once it is done. */
+        bool stepAsyncLoad(SceneLoadOperation& _operation, float _deadline);
+
         void registerGameObjectToMS(const HGameObject& _object);
 
         std::shared_ptr<Scene> mActiveScene;
@@ -90,6 +163,9 @@ namespace Mix {
         uint32_t mNextId = 0;
         std::unordered_map<std::string, uint32_t> mSceneNameIndexMap;
         std::unordered_map<uint32_t, std::shared_ptr<Scene>> mIndexSceneMap;
+
+        std::deque<std::shared_ptr<SceneLoadOperation>> mAsyncLoads;
+        float mAsyncLoadBudget = 4.0f;
     };
 }
 
@@ -13,13 +13,13 @@ namespace Mix {
     class SceneObjectHandle;
 
     /**
-     * \brief Internal data of an SceneObject instance which will be shared by all SceneObject handles that point to the object.
+     * \brief An entry of the slot map owned by SceneObjectManager. A handle refers to a slot by index and
+     *        is only valid while its generation matches the one stored in the slot.
      */
-    struct SceneObjectInstanceData {
-        SceneObjectInstanceData() :object(nullptr), instanceId(0) {}
-
+    struct SceneObjectSlot {
         std::shared_ptr<SceneObject> object;
-        uint64_t instanceId;
+        SceneObject* ptr = nullptr;
+        uint32_t generation = 1;
     };
 
 
@@ -38,24 +38,22 @@ namespace Mix {
 
         const std::string& getName() const { return mName; }
 
-        void setName(const std::string& _name) { mName = _name; }
+        virtual void setName(const std::string& _name) { mName = _name; }
 
         const UUID& getUUID() const { return mUUID; }
 
-        const uint64_t& getInstanceId() const { return mInstanceData->instanceId; }
+        const uint64_t& getInstanceId() const { return mInstanceId; }
 
     public:
         void _setUUID(const UUID& _uuid) { mUUID = _uuid; }
 
-        void _setInstanceId(const uint64_t& _instanceId) { mInstanceData->instanceId = _instanceId; }
+        void _setInstanceId(const uint64_t& _instanceId) { mInstanceId = _instanceId; }
 
         void _setIsDestroyed() { mIsDestroyed = true; }
 
         bool _isDestroyed() const { return mIsDestroyed; }
 
-        std::shared_ptr<SceneObjectInstanceData> _getInstanceData() const { return mInstanceData; }
-
-        void initialize(std::shared_ptr<SceneObject> _object, uint64_t _instanceId);
+        void initialize(uint64_t _instanceId) { mInstanceId = _instanceId; }
 
         virtual void destroyInternal(SceneObjectHandleBase& _handle, bool _immediate = false) = 0;
 
@@ -65,7 +63,7 @@ namespace Mix {
 
     private:
         bool mIsDestroyed = false;
-        std::shared_ptr<SceneObjectInstanceData> mInstanceData;
+        uint64_t mInstanceId = 0;
     };
 
 
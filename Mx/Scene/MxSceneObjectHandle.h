@@ -7,31 +7,26 @@
 #include <memory>
 
 namespace Mix {
-     /**
-     * \brief Internal data of SceneObjectHandle whick can be shared between SceneObject handles;
-     */
-    struct SceneObjectHandleData {
-        SceneObjectHandleData() = default;
-
-        SceneObjectHandleData(std::shared_ptr<SceneObjectInstanceData> _ptr) :mPtr(std::move(_ptr)) {}
-
-        std::shared_ptr<SceneObjectInstanceData> mPtr;
-    };
-
-
     /**
      * \brief The base class of handles that refer to various types of scene objects used to track the whether the object is still alive
+     *
+     *        A handle is a 64-bit id packing the generation (high 32 bits) and the index (low 32 bits) of a slot
+     *        in the slot map of SceneObjectManager. Copying a handle does not touch any reference count and
+     *        dereferencing it is one array load plus a generation compare. Id 0 is the null handle.
      */
     class SceneObjectHandleBase : public Object {
         MX_DECLARE_RTTI;
 
         friend class SceneObjectManager;
     public:
-        SceneObjectHandleBase() :mData(nullptr) {}
+        SceneObjectHandleBase() :mId(0) {}
 
-        bool isDestroyed() const;
+        bool isDestroyed() const {
+            const SceneObjectSlot* slot = getSlot();
+            return slot == nullptr || slot->ptr->_isDestroyed();
+        }
 
-        uint64_t getInstanceId() const { return mData->mPtr ? mData->mPtr->instanceId : 0; }
+        uint64_t getInstanceId() const { return mId; }
 
         std::shared_ptr<SceneObject> get() const;
 
@@ -39,23 +34,42 @@ namespace Mix {
 
         SceneObject& operator*() const { return *getRawPtr(); }
 
-        std::shared_ptr<SceneObjectHandleData> _getHandleData() const { return mData; }
+        /** \brief Get the object while its slot is alive, even if it was already marked as destroyed. */
+        SceneObject* _getPtr() const {
+            const SceneObjectSlot* slot = getSlot();
+            return slot ? slot->ptr : nullptr;
+        }
 
     protected:
-        SceneObjectHandleBase(const std::shared_ptr<SceneObject>& _ptr);
-
-        SceneObjectHandleBase(std::shared_ptr<SceneObjectHandleData> _data) :mData(std::move(_data)) {};
+        explicit SceneObjectHandleBase(uint64_t _id) :mId(_id) {};
 
-        SceneObjectHandleBase(std::nullptr_t) :mData(nullptr) {}
+        SceneObjectHandleBase(std::nullptr_t) :mId(0) {}
 
         void throwIfDestroyed() const;
 
-        void destroy();
+        /** \brief Get the slot this handle refers to, nullptr if the handle is null or the slot was released. */
+        const SceneObjectSlot* getSlot() const {
+            const uint32_t index = static_cast<uint32_t>(mId);
+            const uint32_t generation = static_cast<uint32_t>(mId >> 32);
+            if (index >= sSlotCount)
+                return nullptr;
+            const SceneObjectSlot* slot = sSlots + index;
+            return slot->generation == generation && slot->ptr ? slot : nullptr;
+        }
 
-        SceneObject* getRawPtr() const;
+        SceneObject* getRawPtr() const {
+            const SceneObjectSlot* slot = getSlot();
+            if (slot == nullptr || slot->ptr->_isDestroyed())
+                throwIfDestroyed();
+            return slot->ptr;
+        }
 
-        std::shared_ptr<SceneObjectHandleData> mData;
+        uint64_t mId;
 
+    private:
+        /** \brief Slot storage published by SceneObjectManager, updated whenever it grows. */
+        static const SceneObjectSlot* sSlots;
+        static uint32_t sSlotCount;
     };
 
 
@@ -64,7 +78,6 @@ namespace Mix {
     class SceneObjectHandle : public SceneObjectHandleBase {
     public:
         SceneObjectHandle() :SceneObjectHandleBase() {
-            mData = std::make_shared<SceneObjectHandleData>();
         }
 
         SceneObjectHandle(const SceneObjectHandle& _other) = default;
@@ -75,7 +88,7 @@ namespace Mix {
         }
 
         SceneObjectHandle& operator=(std::nullptr_t) {
-            mData = std::make_shared<SceneObjectHandleData>();
+            mId = 0;
             return *this;
         }
 
@@ -92,13 +105,12 @@ namespace Mix {
         _Ty& operator*() const { return *getRawPtr(); }
 
         explicit operator bool() const {
-            return mData->mPtr != nullptr && mData->mPtr->object != nullptr;
+            return getSlot() != nullptr;
         }
 
         template<typename _T>
         bool operator==(const SceneObjectHandle<_T>& _other) const {
-            return (mData == nullptr && _other.mData == nullptr) ||
-                (mData != nullptr && _other.mData != nullptr && getInstanceId() == _other.getInstanceId());
+            return getInstanceId() == _other.getInstanceId();
         }
 
         template<typename _T>
@@ -107,7 +119,7 @@ namespace Mix {
         }
 
         bool operator==(std::nullptr_t) const {
-            return mData->mPtr == nullptr || mData->mPtr->object == nullptr;
+            return getSlot() == nullptr;
         }
 
         bool operator!=(std::nullptr_t) const {
@@ -125,18 +137,18 @@ namespace Mix {
             return reinterpret_cast<_Ty*>(SceneObjectHandleBase::getRawPtr());
         }
 
-        SceneObjectHandle(std::shared_ptr<SceneObjectHandleData> _data) :SceneObjectHandleBase(std::move(_data)) {}
+        explicit SceneObjectHandle(uint64_t _id) :SceneObjectHandleBase(_id) {}
     };
 
 
     template<class _Ty1, class _Ty2>
     SceneObjectHandle<_Ty1> static_scene_object_cast(const SceneObjectHandle<_Ty2>& _other) {
-        return SceneObjectHandle<_Ty1>(_other.mData);
+        return SceneObjectHandle<_Ty1>(_other.getInstanceId());
     }
 
     template<class _Ty1>
     SceneObjectHandle<_Ty1> static_scene_object_cast(const SceneObjectHandleBase& _other) {
-        return SceneObjectHandle<_Ty1>(_other._getHandleData());
+        return SceneObjectHandle<_Ty1>(_other.getInstanceId());
     }
 }
 
@@ -8,6 +8,12 @@ namespace Mix {
         return MixEngine::Instance().getModule<SceneObjectManager>();
     }
 
+    SceneObjectManager::~SceneObjectManager() {
+        // Every handle reads as destroyed from now on, remaining objects are released together with the slots
+        SceneObjectHandleBase::sSlots = nullptr;
+        SceneObjectHandleBase::sSlotCount = 0;
+    }
+
     void SceneObjectManager::update() {
     }
 
@@ -19,41 +25,120 @@ namespace Mix {
     }
 
     SceneObjectHandleBase SceneObjectManager::registerObject(const std::shared_ptr<SceneObject>& _object) {
-        auto id = ++mNextId;
-        _object->initialize(_object, id);
-        auto handle = SceneObjectHandleBase(_object);
-        mObjects[id] = handle;
-        return handle;
+        uint32_t index;
+        if (!mFreeSlots.empty()) {
+            index = mFreeSlots.back();
+            mFreeSlots.pop_back();
+        }
+        else {
+            index = static_cast<uint32_t>(mSlots.size());
+            mSlots.emplace_back();
+            publishSlots();
+        }
+
+        auto& slot = mSlots[index];
+        slot.object = _object;
+        slot.ptr = _object.get();
+
+        const uint64_t id = static_cast<uint64_t>(slot.generation) << 32 | index;
+        _object->initialize(id);
+        return SceneObjectHandleBase(id);
     }
 
     void SceneObjectManager::unregisterObject(SceneObjectHandleBase& _object) {
-        mObjects.erase(_object.getInstanceId());
+        const uint64_t id = _object.getInstanceId();
+        if (_object.getSlot() == nullptr)
+            return;
+
         onObjectDestroyed.trigger(static_scene_object_cast<GameObject>(_object));
-        _object.destroy();
+        releaseSlot(id);
+    }
+
+    void SceneObjectManager::reserve(uint32_t _count) {
+        if (_count <= mFreeSlots.size())
+            return;
+
+        const size_t required = mSlots.size() + (_count - mFreeSlots.size());
+        if (required > mSlots.capacity()) {
+            mSlots.reserve(required);
+            publishSlots();
+        }
+    }
+
+    void SceneObjectManager::unregisterObjects(const std::vector<SceneObjectHandleBase>& _objects) {
+        if (!onObjectDestroyed.empty()) {
+            for (auto& object : _objects) {
+                if (object.getSlot() != nullptr)
+                    onObjectDestroyed.trigger(static_scene_object_cast<GameObject>(object));
+            }
+        }
+
+        // Destructors may unregister other objects, so they run on a buffer of our own
+        std::vector<std::shared_ptr<SceneObject>> released = std::move(mReleaseScratch);
+        released.reserve(_objects.size());
+
+        for (auto& object : _objects) {
+            if (object.getSlot() == nullptr)
+                continue;
+
+            const uint32_t index = static_cast<uint32_t>(object.getInstanceId());
+            auto& slot = mSlots[index];
+            released.push_back(std::move(slot.object));
+            slot.ptr = nullptr;
+            if (++slot.generation == 0)
+                slot.generation = 1;
+            mFreeSlots.push_back(index);
+        }
+
+        released.clear();
+        if (released.capacity() > mReleaseScratch.capacity())
+            mReleaseScratch = std::move(released);
     }
 
     SceneObjectHandleBase SceneObjectManager::getObject(const uint64_t& _instanceId) const {
-        auto it = mObjects.find(_instanceId);
-        if (it != mObjects.end())
-            return it->second;
+        SceneObjectHandleBase handle(_instanceId);
+        if (handle.getSlot() != nullptr)
+            return handle;
         return nullptr;
     }
 
     bool SceneObjectManager::objectExists(const uint64_t& _instanceId) const {
-        return mObjects.find(_instanceId) != mObjects.end();
+        return SceneObjectHandleBase(_instanceId).getSlot() != nullptr;
     }
 
     void SceneObjectManager::pushToDestroyQueue(const SceneObjectHandleBase& _object) {
-        if (_object.isDestroyed())
+        // Components removed from their GameObject are already marked as destroyed but still need releasing
+        if (_object.getSlot() == nullptr)
             return;
-        auto id = _object.getInstanceId();
-        mDestroyQueue[id] = _object;
+        mDestroyQueue.push_back(_object);
     }
 
     void SceneObjectManager::destroyObjectsInQueue() {
-        for (auto& objPair : mDestroyQueue)
-            objPair.second->destroyInternal(objPair.second, true);
+        // An object queued twice, or already released together with its hierarchy, has no slot any more
+        for (size_t i = 0; i < mDestroyQueue.size(); ++i) {
+            SceneObjectHandleBase handle = mDestroyQueue[i];
+            if (SceneObject* object = handle._getPtr())
+                object->destroyInternal(handle, true);
+        }
         mDestroyQueue.clear();
     }
 
+    void SceneObjectManager::publishSlots() const {
+        SceneObjectHandleBase::sSlots = mSlots.data();
+        SceneObjectHandleBase::sSlotCount = static_cast<uint32_t>(mSlots.size());
+    }
+
+    void SceneObjectManager::releaseSlot(uint64_t _id) {
+        const uint32_t index = static_cast<uint32_t>(_id);
+        auto& slot = mSlots[index];
+
+        // Move the object out first, its destructor may register or release other objects
+        std::shared_ptr<SceneObject> object = std::move(slot.object);
+        slot.ptr = nullptr;
+        if (++slot.generation == 0)
+            slot.generation = 1;
+        mFreeSlots.push_back(index);
+
+        object.reset();
+    }
 }
@@ -2,21 +2,25 @@
 #ifndef MX_SCENE_OBJECT_MANAGER_H_
 #define MX_SCENE_OBJECT_MANAGER_H_
 #include "../Engine/MxModuleBase.h"
-#include "../Utils/MxEvent.h"
+#include "../Utils/MxLocalEvent.h"
 #include "../Definitions/MxDefinitions.h"
-#include <map>
+#include "MxSceneObject.h"
+#include <vector>
 
 namespace Mix {
     class SceneObject;
     class SceneObjectHandleBase;
 
+    /**
+     * \brief Owns every SceneObject through a generational slot map, handles refer to slots by index and generation.
+     */
     class SceneObjectManager :public ModuleBase {
     public:
         static SceneObjectManager* Get();
 
         SceneObjectManager() = default;
 
-        ~SceneObjectManager() = default;
+        ~SceneObjectManager();
 
         void load() override {}
 
@@ -32,6 +36,15 @@ namespace Mix {
 
         void unregisterObject(SceneObjectHandleBase& _object);
 
+        /** \brief Make sure the next _count objects can be registered without growing the slot storage. */
+        void reserve(uint32_t _count);
+
+        /**
+         * \brief Unregister a batch of objects. onObjectDestroyed is fired for every object first, then all
+         *        slots are released in one sweep and the objects are deleted in the order given.
+         */
+        void unregisterObjects(const std::vector<SceneObjectHandleBase>& _objects);
+
         SceneObjectHandleBase getObject(const uint64_t& _instanceId) const;
 
         bool objectExists(const uint64_t& _instanceId) const;
@@ -40,12 +53,25 @@ namespace Mix {
 
         void destroyObjectsInQueue();
 
-        Event<void(HGameObject)> onObjectDestroyed;
+        LocalEvent<void(HGameObject)> onObjectDestroyed;
+
+        /** \brief Get the amount of alive objects. */
+        uint32_t objectCount() const { return static_cast<uint32_t>(mSlots.size() - mFreeSlots.size()); }
 
     private:
-        uint64_t mNextId = 0;
-        std::map<uint64_t, SceneObjectHandleBase> mObjects;
-        std::map<uint64_t, SceneObjectHandleBase> mDestroyQueue;
+        /** \brief Make the slot storage visible to handles after it may have been reallocated. */
+        void publishSlots() const;
+
+        /** \brief Bump the generation of the slot referred to by _id and release its object. */
+        void releaseSlot(uint64_t _id);
+
+        std::vector<SceneObjectSlot> mSlots;
+        std::vector<uint32_t> mFreeSlots;
+        /** \brief Objects to destroy at the end of the frame, duplicates are skipped since they read as destroyed. */
+        std::vector<SceneObjectHandleBase> mDestroyQueue;
+
+        /** \brief Objects moved out of their slots by unregisterObjects(), kept to reuse the capacity. */
+        std::vector<std::shared_ptr<SceneObject>> mReleaseScratch;
     };
 }
 
@@ -0,0 +1,246 @@
+#include "MxSceneSerializer.h"
+#include "MxScene.h"
+#include "../Component/Camera/MxCamera.h"
+#include "../Component/MeshFilter/MxMeshFilter.h"
+#include "../Component/Renderer/MxRenderer.h"
+#include "../Log/MxLog.h"
+#include <fstream>
+#include <unordered_set>
+
+namespace Mix {
+    void ScenePayloadWriter::writeString(const std::string& _string) {
+        write(static_cast<uint32_t>(_string.size()));
+        mBytes.insert(mBytes.end(), _string.begin(), _string.end());
+    }
+
+    void ScenePayloadWriter::writeResource(const std::shared_ptr<ResourceBase>& _resource) {
+        write(mResourceIndex(_resource));
+    }
+
+    std::string ScenePayloadReader::readString() {
+        const auto length = read<uint32_t>();
+        const auto chars = reinterpret_cast<const char*>(take(length));
+        return std::string(chars, length);
+    }
+
+    std::shared_ptr<ResourceBase> ScenePayloadReader::readResource() {
+        const auto index = read<uint32_t>();
+        return index < mResources.size() ? mResources[index] : nullptr;
+    }
+
+    const uint8_t* ScenePayloadReader::take(size_t _size) {
+        if (_size > mSize - mOffset)
+            MX_EXCEPT("Component payload is shorter than expected.");
+        const uint8_t* data = mData + mOffset;
+        mOffset += _size;
+        return data;
+    }
+
+    ComponentSerializers& ComponentSerializers::Get() {
+        static ComponentSerializers serializers;
+        return serializers;
+    }
+
+    ComponentSerializers::ComponentSerializers() {
+        registerType<MeshFilter>(
+            [](const MeshFilter& _filter, ScenePayloadWriter& _writer) {
+                _writer.writeResource(_filter.getMesh());
+            },
+            [](GameObject& _object, ScenePayloadReader& _reader) {
+                _object.addComponent<MeshFilter>()->setMesh(_reader.readResource<Mesh>());
+            });
+
+        // Materials aren't resources, they have to be assigned after loading
+        registerType<Renderer>(
+            [](const Renderer& _renderer, ScenePayloadWriter& _writer) {
+                _writer.write<uint8_t>(_renderer.isEnable());
+            },
+            [](GameObject& _object, ScenePayloadReader& _reader) {
+                _object.addComponent<Renderer>()->setEnable(_reader.read<uint8_t>() != 0);
+            });
+
+        registerType<Camera>(
+            [](const Camera& _camera, ScenePayloadWriter& _writer) {
+                const auto scene = _camera.getGameObject()->getScene();
+                _writer.write(_camera.getFov());
+                _writer.write(_camera.getExtent().x);
+                _writer.write(_camera.getExtent().y);
+                _writer.write<uint8_t>(scene && scene->isMainCamera(static_scene_object_cast<Camera>(_camera.getHandle())));
+            },
+            [](GameObject& _object, ScenePayloadReader& _reader) {
+                const auto fov = _reader.read<float>();
+                const auto width = _reader.read<int32_t>();
+                const auto height = _reader.read<int32_t>();
+                const bool isMain = _reader.read<uint8_t>() != 0;
+
+                auto camera = _object.addComponent<Camera>(Vector2i(width, height), fov);
+                if (auto scene = _object.getScene()) {
+                    // Every Prefab instance would take over the main camera in turn
+                    if (isMain && !_reader.isPrefabInstance())
+                        scene->setMainCamera(camera);
+                    else
+                        scene->registerCamera(camera);
+                }
+            });
+    }
+
+    const ComponentSerializers::Entry* ComponentSerializers::find(const Rtti& _type) const {
+        auto entry = find(TypeHash(_type));
+        return entry && entry->type == &_type ? entry : nullptr;
+    }
+
+    const ComponentSerializers::Entry* ComponentSerializers::find(uint64_t _typeHash) const {
+        auto it = mEntries.find(_typeHash);
+        return it != mEntries.end() ? &it->second : nullptr;
+    }
+
+    void SceneWriter::addResourcePath(const std::shared_ptr<ResourceBase>& _resource, const std::string& _path, int32_t _subIndex) {
+        if (_resource)
+            mResourcePaths[_resource.get()] = ResourcePath{ _path, _subIndex };
+    }
+
+    bool SceneWriter::write(const Scene& _scene, const std::filesystem::path& _path) {
+        mResourceIndices.clear();
+        mStringRefs.clear();
+        mResources.clear();
+        mStrings.clear();
+
+        std::vector<SceneFormat::ObjectRecord> objects;
+        std::vector<SceneFormat::ComponentRecord> components;
+        std::vector<uint8_t> payload;
+        ScenePayloadWriter payloadWriter([this](const std::shared_ptr<ResourceBase>& _resource) { return resourceIndex(_resource); }, payload);
+        std::unordered_set<const Rtti*> skippedTypes;
+
+        // Pre-order, each entry is a GameObject and the index of its parent record
+        std::vector<std::pair<GameObject*, uint32_t>> stack;
+        auto roots = _scene.getRootGameObjects();
+        for (auto it = roots.rbegin(); it != roots.rend(); ++it)
+            stack.emplace_back(it->operator->(), SceneFormat::InvalidIndex);
+
+        while (!stack.empty()) {
+            const auto [object, parent] = stack.back();
+            stack.pop_back();
+
+            const uint32_t index = static_cast<uint32_t>(objects.size());
+            const Transform& transform = object->transform();
+
+            SceneFormat::ObjectRecord record{};
+            record.parent = parent;
+            record.name = addString(object->getName());
+            record.tag = addString(object->getTag());
+            record.layer = object->getLayer();
+            record.flags = static_cast<uint32_t>(object->getFlags());
+            record.activeSelf = object->activeSelf();
+            record.localPosition[0] = transform.getLocalPosition().x;
+            record.localPosition[1] = transform.getLocalPosition().y;
+            record.localPosition[2] = transform.getLocalPosition().z;
+            record.localRotation[0] = transform.getLocalRotation().x;
+            record.localRotation[1] = transform.getLocalRotation().y;
+            record.localRotation[2] = transform.getLocalRotation().z;
+            record.localRotation[3] = transform.getLocalRotation().w;
+            record.localScale[0] = transform.getLocalScale().x;
+            record.localScale[1] = transform.getLocalScale().y;
+            record.localScale[2] = transform.getLocalScale().z;
+
+            record.firstComponent = static_cast<uint32_t>(components.size());
+            for (auto& handle : object->_getComponents()) {
+                const Component& component = *handle;
+                if (component.isSameType(Transform::GetType()))
+                    continue;
+
+                auto entry = ComponentSerializers::Get().find(component.getType());
+                if (!entry) {
+                    if (skippedTypes.insert(&component.getType()).second)
+                        MX_LOG_WARNING("Components of type [%1%] can't be serialized and are skipped.", component.getTypeName());
+                    continue;
+                }
+
+                SceneFormat::ComponentRecord componentRecord{};
+                componentRecord.typeHash = ComponentSerializers::TypeHash(component.getType());
+                componentRecord.payloadOffset = static_cast<uint32_t>(payload.size());
+                entry->write(component, payloadWriter);
+                componentRecord.payloadSize = static_cast<uint32_t>(payload.size()) - componentRecord.payloadOffset;
+                components.push_back(componentRecord);
+            }
+            record.componentCount = static_cast<uint32_t>(components.size()) - record.firstComponent;
+            objects.push_back(record);
+
+            for (uint32_t i = object->getChildrenCount(); i-- > 0;)
+                stack.emplace_back(object->getChild(i).operator->(), index);
+        }
+
+        // Lay the tables out, each one 8-byte aligned
+        uint32_t fileSize = sizeof(SceneFormat::Header);
+        auto place = [&fileSize](size_t _size) {
+            fileSize = (fileSize + SceneFormat::TableAlignment - 1) & ~(SceneFormat::TableAlignment - 1);
+            const uint32_t offset = fileSize;
+            fileSize += static_cast<uint32_t>(_size);
+            return offset;
+        };
+
+        SceneFormat::Header header{};
+        header.magic = SceneFormat::Magic;
+        header.version = SceneFormat::Version;
+        header.objectCount = static_cast<uint32_t>(objects.size());
+        header.objectOffset = place(objects.size() * sizeof(SceneFormat::ObjectRecord));
+        header.componentCount = static_cast<uint32_t>(components.size());
+        header.componentOffset = place(components.size() * sizeof(SceneFormat::ComponentRecord));
+        header.resourceCount = static_cast<uint32_t>(mResources.size());
+        header.resourceOffset = place(mResources.size() * sizeof(SceneFormat::ResourceRecord));
+        header.stringsSize = static_cast<uint32_t>(mStrings.size());
+        header.stringsOffset = place(mStrings.size());
+        header.payloadSize = static_cast<uint32_t>(payload.size());
+        header.payloadOffset = place(payload.size());
+
+        std::vector<uint8_t> bytes(fileSize, 0);
+        auto copy = [&bytes](uint32_t _offset, const void* _data, size_t _size) {
+            if (_size != 0)
+                std::memcpy(bytes.data() + _offset, _data, _size);
+        };
+        copy(0, &header, sizeof(header));
+        copy(header.objectOffset, objects.data(), objects.size() * sizeof(SceneFormat::ObjectRecord));
+        copy(header.componentOffset, components.data(), components.size() * sizeof(SceneFormat::ComponentRecord));
+        copy(header.resourceOffset, mResources.data(), mResources.size() * sizeof(SceneFormat::ResourceRecord));
+        copy(header.stringsOffset, mStrings.data(), mStrings.size());
+        copy(header.payloadOffset, payload.data(), payload.size());
+
+        std::ofstream file(_path, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size())) {
+            MX_LOG_ERROR("Failed to write scene [%1%] to [%2%].", _scene.getName(), _path.string());
+            return false;
+        }
+        return true;
+    }
+
+    uint32_t SceneWriter::resourceIndex(const std::shared_ptr<ResourceBase>& _resource) {
+        if (!_resource)
+            return SceneFormat::InvalidIndex;
+
+        auto it = mResourceIndices.find(_resource.get());
+        if (it != mResourceIndices.end())
+            return it->second;
+
+        uint32_t index = SceneFormat::InvalidIndex;
+        auto path = mResourcePaths.find(_resource.get());
+        if (path != mResourcePaths.end()) {
+            index = static_cast<uint32_t>(mResources.size());
+            mResources.push_back(SceneFormat::ResourceRecord{ addString(path->second.path), path->second.subIndex, 0 });
+        }
+        else
+            MX_LOG_WARNING("A resource of type [%1%] has no known path, it is written as a null reference.", _resource->getTypeName());
+
+        mResourceIndices[_resource.get()] = index;
+        return index;
+    }
+
+    SceneFormat::StringRef SceneWriter::addString(const std::string& _string) {
+        auto it = mStringRefs.find(_string);
+        if (it != mStringRefs.end())
+            return it->second;
+
+        SceneFormat::StringRef ref{ static_cast<uint32_t>(mStrings.size()), static_cast<uint32_t>(_string.size()) };
+        mStrings.insert(mStrings.end(), _string.begin(), _string.end());
+        mStringRefs.emplace(_string, ref);
+        return ref;
+    }
+}
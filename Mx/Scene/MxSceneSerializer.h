@@ -0,0 +1,181 @@
+#pragma once
+#ifndef MX_SCENE_SERIALIZER_H_
+#define MX_SCENE_SERIALIZER_H_
+
+#include "MxSceneFormat.h"
+#include "../GameObject/MxGameObject.h"
+#include "../Resource/MxResourceBase.h"
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Mix {
+    class Scene;
+
+    /**
+     * \brief Appends the payload of one Component to a scene file or a Prefab being written.
+     */
+    class ScenePayloadWriter {
+    public:
+        /** \brief Maps a resource to its index in the resource table of the owner of the payload. */
+        using ResourceIndexFunc = std::function<uint32_t(const std::shared_ptr<ResourceBase>&)>;
+
+        ScenePayloadWriter(ResourceIndexFunc _resourceIndex, std::vector<uint8_t>& _bytes)
+            :mResourceIndex(std::move(_resourceIndex)), mBytes(_bytes) {
+        }
+
+        template<typename _Ty>
+        void write(const _Ty& _value) {
+            static_assert(std::is_trivially_copyable_v<_Ty>, "Only trivially copyable values can be written as raw bytes");
+            const auto bytes = reinterpret_cast<const uint8_t*>(&_value);
+            mBytes.insert(mBytes.end(), bytes, bytes + sizeof(_Ty));
+        }
+
+        void writeString(const std::string& _string);
+
+        /** \brief Write a reference to _resource, for scene files see SceneWriter::addResourcePath(). */
+        void writeResource(const std::shared_ptr<ResourceBase>& _resource);
+
+    private:
+        ResourceIndexFunc mResourceIndex;
+        std::vector<uint8_t>& mBytes;
+    };
+
+
+    /**
+     * \brief Reads the payload of one Component from a scene file, in the order it was written.
+     */
+    class ScenePayloadReader {
+    public:
+        /** \param _prefabInstance Whether the Component is created for a Prefab instance rather than a loaded scene. */
+        ScenePayloadReader(const uint8_t* _data, size_t _size, const std::vector<std::shared_ptr<ResourceBase>>& _resources, bool _prefabInstance = false)
+            :mData(_data), mSize(_size), mResources(_resources), mPrefabInstance(_prefabInstance) {
+        }
+
+        bool isPrefabInstance() const { return mPrefabInstance; }
+
+        template<typename _Ty>
+        _Ty read() {
+            static_assert(std::is_trivially_copyable_v<_Ty>, "Only trivially copyable values can be read as raw bytes");
+            _Ty value;
+            std::memcpy(&value, take(sizeof(_Ty)), sizeof(_Ty));
+            return value;
+        }
+
+        std::string readString();
+
+        /** \return The referenced resource, nullptr if the reference was null or the resource failed to load. */
+        std::shared_ptr<ResourceBase> readResource();
+
+        template<typename _Ty>
+        std::shared_ptr<_Ty> readResource() { return rtti_pointer_cast<_Ty>(readResource()); }
+
+    private:
+        /** \brief Consume _size bytes, throws if the payload is shorter. */
+        const uint8_t* take(size_t _size);
+
+        const uint8_t* mData;
+        size_t mSize;
+        size_t mOffset = 0;
+        const std::vector<std::shared_ptr<ResourceBase>>& mResources;
+        bool mPrefabInstance;
+    };
+
+
+    /**
+     * \brief Registry of the Component types that can be saved to and restored from scene files.
+     *
+     *        Types are identified in files by a hash of their Rtti name. MeshFilter, Renderer and
+     *        Camera are registered by default, Components of unregistered types are skipped when
+     *        a scene is written.
+     */
+    class ComponentSerializers {
+    public:
+        using WriteFunc = std::function<void(const Component&, ScenePayloadWriter&)>;
+
+        /** \brief Add a Component restored from the payload to the GameObject. */
+        using CreateFunc = std::function<void(GameObject&, ScenePayloadReader&)>;
+
+        /** \brief Reserve room for _count more Components in the pool of the type. */
+        using ReserveFunc = void(*)(uint32_t);
+
+        struct Entry {
+            const Rtti* type;
+            WriteFunc write;
+            CreateFunc create;
+            ReserveFunc reserve;
+        };
+
+        static ComponentSerializers& Get();
+
+        static uint64_t TypeHash(const Rtti& _type) { return SceneFormat::HashName(_type.getName().data(), _type.getName().size()); }
+
+        template<typename _Ty>
+        void registerType(std::function<void(const _Ty&, ScenePayloadWriter&)> _write, CreateFunc _create);
+
+        /** \return The serializer of the exact type _type, nullptr if it isn't registered. */
+        const Entry* find(const Rtti& _type) const;
+
+        const Entry* find(uint64_t _typeHash) const;
+
+    private:
+        ComponentSerializers();
+
+        std::unordered_map<uint64_t, Entry> mEntries;
+    };
+
+    template<typename _Ty>
+    void ComponentSerializers::registerType(std::function<void(const _Ty&, ScenePayloadWriter&)> _write, CreateFunc _create) {
+        static_assert(std::is_base_of_v<Component, _Ty>, "Only Components can be serialized");
+
+        auto write = [write = std::move(_write)](const Component& _component, ScenePayloadWriter& _writer) {
+            write(static_cast<const _Ty&>(_component), _writer);
+        };
+        auto reserve = [](uint32_t _count) { ComponentPool<_Ty>::Get().reserve(_count); };
+        mEntries[TypeHash(_Ty::GetType())] = Entry{ &_Ty::GetType(), std::move(write), std::move(_create), reserve };
+    }
+
+
+    /**
+     * \brief Snapshots a live Scene into a binary scene file.
+     *
+     *        The engine doesn't track where resources came from, so every resource referenced by a
+     *        Component has to be announced through addResourcePath() first. Unknown resources are
+     *        written as null references.
+     */
+    class SceneWriter {
+    public:
+        /**
+         * \brief Tell the writer that _resource was loaded from _path.
+         * \param _subIndex Index of _resource inside the file, e.g. of a Mesh inside a Model, -1 for the file itself.
+         */
+        void addResourcePath(const std::shared_ptr<ResourceBase>& _resource, const std::string& _path, int32_t _subIndex = -1);
+
+        /** \brief Write every GameObject of _scene with its Transform and serializable Components to _path. */
+        bool write(const Scene& _scene, const std::filesystem::path& _path);
+
+    private:
+        /** \brief Get the index of _resource in the resource table, adding it on first use. */
+        uint32_t resourceIndex(const std::shared_ptr<ResourceBase>& _resource);
+
+        SceneFormat::StringRef addString(const std::string& _string);
+
+        struct ResourcePath {
+            std::string path;
+            int32_t subIndex;
+        };
+
+        std::unordered_map<const ResourceBase*, ResourcePath> mResourcePaths;
+
+        // Per write() state
+        std::unordered_map<const ResourceBase*, uint32_t> mResourceIndices;
+        std::unordered_map<std::string, SceneFormat::StringRef> mStringRefs;
+        std::vector<SceneFormat::ResourceRecord> mResources;
+        std::vector<char> mStrings;
+    };
+}
+
+#endif
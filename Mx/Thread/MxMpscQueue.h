@@ -0,0 +1,93 @@
+#pragma once
+#ifndef MX_MPSC_QUEUE_H_
+#define MX_MPSC_QUEUE_H_
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace Mix {
+    /**
+     * \brief Unbounded lock-free queue, any thread may push, a single thread pops.
+     *
+     *        Producers only exchange the head pointer, so a push never waits for another thread. A pop may
+     *        see the queue as empty while a push is halfway done, the element shows up on a later pop.
+     */
+    template<typename _Ty>
+    class MpscQueue {
+    public:
+        MpscQueue() :mHead(&mStub), mTail(&mStub) {}
+
+        ~MpscQueue() {
+            while (pop());
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        /** \brief Thread-safe. */
+        template<typename... _Args>
+        void push(_Args&&... _args) {
+            pushNode(new ValueNode(std::forward<_Args>(_args)...));
+        }
+
+        /** \brief Only call from the consumer thread. */
+        std::optional<_Ty> pop() {
+            Node* tail = mTail;
+            Node* next = tail->next.load(std::memory_order_acquire);
+
+            // Skip the stub, it only keeps the list from becoming empty
+            if (tail == &mStub) {
+                if (next == nullptr)
+                    return std::nullopt;
+                mTail = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+
+            if (next == nullptr) {
+                // tail is the last element unless a producer is between its exchange and its link
+                if (tail != mHead.load(std::memory_order_acquire))
+                    return std::nullopt;
+
+                pushNode(&mStub);
+                next = tail->next.load(std::memory_order_acquire);
+                if (next == nullptr)
+                    return std::nullopt;
+            }
+
+            mTail = next;
+            auto node = static_cast<ValueNode*>(tail);
+            std::optional<_Ty> value(std::move(node->value));
+            delete node;
+            return value;
+        }
+
+    private:
+        struct Node {
+            std::atomic<Node*> next{ nullptr };
+        };
+
+        struct ValueNode :Node {
+            template<typename... _Args>
+            explicit ValueNode(_Args&&... _args) :value(std::forward<_Args>(_args)...) {}
+
+            _Ty value;
+        };
+
+        void pushNode(Node* _node) {
+            _node->next.store(nullptr, std::memory_order_relaxed);
+            Node* prev = mHead.exchange(_node, std::memory_order_acq_rel);
+            prev->next.store(_node, std::memory_order_release);
+        }
+
+        std::atomic<Node*> mHead;
+        Node mStub;
+
+        /** \brief Only touched by the consumer, kept away from the cache line of the producers. */
+        alignas(64) Node* mTail;
+    };
+}
+
+#endif
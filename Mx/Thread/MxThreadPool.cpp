@@ -0,0 +1,83 @@
+#include "MxThreadPool.h"
+#include "../../MixEngine.h"
+#include <algorithm>
+
+namespace Mix {
+    ThreadPool* ThreadPool::Get() {
+        return MixEngine::Instance().getModule<ThreadPool>();
+    }
+
+    ThreadPool::ThreadPool(uint32_t _threadCount) :mRequestedThreadCount(_threadCount) {
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mCondition.notify_all();
+
+        for (auto& worker : mWorkers)
+            worker.join();
+    }
+
+    void ThreadPool::load() {
+        uint32_t count = mRequestedThreadCount;
+        if (count == 0) {
+            const uint32_t hardware = std::thread::hardware_concurrency();
+            count = hardware > 1 ? hardware - 1 : 0;
+        }
+
+        mWorkers.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+            mWorkers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+
+    void ThreadPool::schedule(Job _job) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mJobs.push_back(std::move(_job));
+        }
+        mCondition.notify_one();
+    }
+
+    void ThreadPool::RunChunks(ParallelForState& _state) {
+        while (true) {
+            const uint32_t chunk = _state.nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= _state.chunkCount)
+                return;
+
+            const uint32_t begin = _state.begin + chunk * _state.grainSize;
+            const uint32_t end = std::min(begin + _state.grainSize, _state.end);
+            (*_state.func)(begin, end);
+
+            _state.remaining.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void ThreadPool::workerLoop() {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this] { return mStop || !mJobs.empty(); });
+
+                if (mStop && mJobs.empty())
+                    return;
+
+                job = std::move(mJobs.front());
+                mJobs.pop_front();
+            }
+            job();
+        }
+    }
+
+    void ThreadPool::scheduleHelpers(const Job& _job, const uint32_t _count) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (uint32_t i = 0; i < _count; ++i)
+                mJobs.push_front(_job);
+        }
+        mCondition.notify_all();
+    }
+}
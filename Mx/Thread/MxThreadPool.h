@@ -0,0 +1,115 @@
+#pragma once
+
+#ifndef MX_THREAD_POOL_H_
+#define MX_THREAD_POOL_H_
+
+#include "../Engine/MxModuleBase.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Mix {
+    /**
+     * \brief A fixed set of worker threads executing jobs pushed from any thread.
+     */
+    class ThreadPool final : public ModuleBase {
+    public:
+        using Job = std::function<void()>;
+
+        static ThreadPool* Get();
+
+        /**
+         * \param _threadCount Amount of worker threads, 0 to use one less than the amount of hardware threads.
+         */
+        explicit ThreadPool(uint32_t _threadCount = 0);
+
+        ~ThreadPool();
+
+        void load() override;
+
+        /** \brief Get the amount of worker threads, the calling thread is not included. */
+        uint32_t threadCount() const { return static_cast<uint32_t>(mWorkers.size()); }
+
+        /** \brief Push a job to be executed by a worker thread, nothing executes it if threadCount() is 0. */
+        void schedule(Job _job);
+
+        /**
+         * \brief Split [_begin, _end) into chunks of at most _grainSize elements and execute
+         *        _func(chunkBegin, chunkEnd) on them in parallel. The calling thread takes part in
+         *        the work and returns once every chunk has been executed. It only ever executes chunks
+         *        of this call, never a job pushed with schedule().
+         * \note  _func must not throw.
+         */
+        template<typename _Func>
+        void parallelFor(uint32_t _begin, uint32_t _end, uint32_t _grainSize, _Func&& _func);
+
+    private:
+        struct ParallelForState {
+            std::atomic<uint32_t> nextChunk{ 0 };
+            std::atomic<uint32_t> remaining{ 0 };
+            uint32_t chunkCount = 0;
+            uint32_t begin = 0;
+            uint32_t end = 0;
+            uint32_t grainSize = 0;
+            const std::function<void(uint32_t, uint32_t)>* func = nullptr;
+        };
+
+        /** \brief Execute chunks of _state until none is left. */
+        static void RunChunks(ParallelForState& _state);
+
+        void workerLoop();
+
+        /** \brief Push _count copies of a parallelFor helper ahead of the scheduled jobs, which may be long. */
+        void scheduleHelpers(const Job& _job, uint32_t _count);
+
+        uint32_t mRequestedThreadCount;
+        std::vector<std::thread> mWorkers;
+
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::deque<Job> mJobs;
+        bool mStop = false;
+    };
+
+    template<typename _Func>
+    void ThreadPool::parallelFor(uint32_t _begin, uint32_t _end, uint32_t _grainSize, _Func&& _func) {
+        if (_begin >= _end)
+            return;
+
+        if (_grainSize == 0)
+            _grainSize = 1;
+
+        const uint32_t chunkCount = (_end - _begin + _grainSize - 1) / _grainSize;
+        if (chunkCount == 1 || mWorkers.empty()) {
+            _func(_begin, _end);
+            return;
+        }
+
+        const std::function<void(uint32_t, uint32_t)> func = std::forward<_Func>(_func);
+
+        // Helpers may start after the caller has returned, they only touch the shared state then
+        auto state = std::make_shared<ParallelForState>();
+        state->remaining = chunkCount;
+        state->chunkCount = chunkCount;
+        state->begin = _begin;
+        state->end = _end;
+        state->grainSize = _grainSize;
+        state->func = &func;
+
+        scheduleHelpers([state] { RunChunks(*state); }, std::min(threadCount(), chunkCount - 1));
+
+        RunChunks(*state);
+
+        // Every chunk is taken, the ones left are being executed by helpers
+        while (state->remaining.load(std::memory_order_acquire) != 0)
+            std::this_thread::yield();
+    }
+}
+
+#endif
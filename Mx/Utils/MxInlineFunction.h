@@ -0,0 +1,125 @@
+#pragma once
+#ifndef MX_INLINE_FUNCTION_H_
+#define MX_INLINE_FUNCTION_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Mix {
+    template<typename _Ty>
+    class InlineFunction;
+
+    /**
+     * \brief Move-only std::function keeping callables of up to BufferSize bytes in place.
+     *
+     *        Lambdas capturing a few pointers and std::bind of a member function never allocate,
+     *        larger callables fall back to the heap.
+     */
+    template<typename _ReType, typename... _Args>
+    class InlineFunction<_ReType(_Args...)> {
+    public:
+        static constexpr size_t BufferSize = 4 * sizeof(void*);
+
+        InlineFunction() = default;
+
+        InlineFunction(std::nullptr_t) {}
+
+        template<typename _Func, typename = std::enable_if_t<!std::is_same_v<std::decay_t<_Func>, InlineFunction>>>
+        InlineFunction(_Func&& _func) {
+            using Callable = std::decay_t<_Func>;
+            if constexpr (IsInline<Callable>) {
+                new (mStorage) Callable(std::forward<_Func>(_func));
+                mInvoke = [](void* _storage, _Args... _args) -> _ReType {
+                    return Invoke(*static_cast<Callable*>(_storage), std::forward<_Args>(_args)...);
+                };
+                mManage = [](void* _dst, void* _src) {
+                    auto src = static_cast<Callable*>(_src);
+                    if (_dst)
+                        new (_dst) Callable(std::move(*src));
+                    src->~Callable();
+                };
+            }
+            else {
+                new (mStorage) Callable*(new Callable(std::forward<_Func>(_func)));
+                mInvoke = [](void* _storage, _Args... _args) -> _ReType {
+                    return Invoke(**static_cast<Callable**>(_storage), std::forward<_Args>(_args)...);
+                };
+                mManage = [](void* _dst, void* _src) {
+                    auto src = static_cast<Callable**>(_src);
+                    if (_dst)
+                        new (_dst) Callable*(*src);
+                    else
+                        delete *src;
+                };
+            }
+        }
+
+        InlineFunction(InlineFunction&& _other) noexcept {
+            moveFrom(_other);
+        }
+
+        InlineFunction& operator=(InlineFunction&& _other) noexcept {
+            if (this != &_other) {
+                reset();
+                moveFrom(_other);
+            }
+            return *this;
+        }
+
+        InlineFunction(const InlineFunction&) = delete;
+
+        InlineFunction& operator=(const InlineFunction&) = delete;
+
+        ~InlineFunction() { reset(); }
+
+        _ReType operator()(_Args... _args) const {
+            return mInvoke(mStorage, std::forward<_Args>(_args)...);
+        }
+
+        explicit operator bool() const { return mInvoke != nullptr; }
+
+        void reset() {
+            if (mManage)
+                mManage(nullptr, mStorage);
+            mInvoke = nullptr;
+            mManage = nullptr;
+        }
+
+    private:
+        using InvokeFunc = _ReType(*)(void*, _Args...);
+
+        /** \brief Move the callable in _src to _dst and destroy the one in _src, only destroy it if _dst is nullptr. */
+        using ManageFunc = void(*)(void* _dst, void* _src);
+
+        template<typename _Callable>
+        static constexpr bool IsInline = sizeof(_Callable) <= BufferSize &&
+            alignof(_Callable) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<_Callable>;
+
+        /** \brief Call _callable, discarding its result like std::function does when _ReType is void. */
+        template<typename _Callable>
+        static _ReType Invoke(_Callable& _callable, _Args... _args) {
+            if constexpr (std::is_void_v<_ReType>)
+                _callable(std::forward<_Args>(_args)...);
+            else
+                return _callable(std::forward<_Args>(_args)...);
+        }
+
+        void moveFrom(InlineFunction& _other) {
+            if (_other.mManage)
+                _other.mManage(mStorage, _other.mStorage);
+            mInvoke = _other.mInvoke;
+            mManage = _other.mManage;
+            _other.mInvoke = nullptr;
+            _other.mManage = nullptr;
+        }
+
+        alignas(std::max_align_t) mutable std::byte mStorage[BufferSize];
+        InvokeFunc mInvoke = nullptr;
+        ManageFunc mManage = nullptr;
+    };
+}
+
+#endif
@@ -0,0 +1,237 @@
+#pragma once
+#ifndef MX_LOCAL_EVENT_H_
+#define MX_LOCAL_EVENT_H_
+
+#include "MxInlineFunction.h"
+#include "../Thread/MxMpscQueue.h"
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace Mix {
+    /** \brief Part of a LocalEvent its handles refer to, so that a handle may outlive the event. */
+    class LocalEventData {
+    public:
+        virtual ~LocalEventData() = default;
+
+        virtual void disconnect(uint32_t _id) = 0;
+    };
+
+    class LocalEventHandle {
+    public:
+        LocalEventHandle() = default;
+
+        LocalEventHandle(std::weak_ptr<LocalEventData> _eventData, uint32_t _id)
+            :mEventData(std::move(_eventData)), mId(_id) {
+        }
+
+        void disconnect() {
+            if (auto eventData = mEventData.lock())
+                eventData->disconnect(mId);
+            mEventData.reset();
+        }
+
+    private:
+        std::weak_ptr<LocalEventData> mEventData;
+        uint32_t mId = 0;
+    };
+
+    template<typename _Ty>
+    class LocalEvent;
+
+    /**
+     * \brief Event confined to the thread that owns it, nothing is locked.
+     *
+     *        Callbacks are kept in a contiguous array and stored in place when they are small enough. They
+     *        may connect, disconnect, trigger the event again or destroy it while it is being triggered.
+     *        Use Event for events connected or triggered from several threads.
+     */
+    template<typename _ReType, typename... _Args>
+    class LocalEvent<_ReType(_Args...)> {
+    public:
+        using Function = InlineFunction<_ReType(_Args...)>;
+
+        LocalEvent() :mData(std::make_shared<Data>()) {}
+
+        ~LocalEvent();
+
+        LocalEvent(const LocalEvent&) = delete;
+
+        LocalEvent& operator=(const LocalEvent&) = delete;
+
+        LocalEventHandle connect(Function _func);
+
+        void operator()(_Args... _args) { trigger(_args...); }
+
+        void trigger(_Args... _args);
+
+        void clear();
+
+        bool empty() const { return mData->connectionCount == 0; }
+
+    private:
+        struct Slot {
+            Function func;
+
+            /** \brief 0 once disconnected, the slot is removed after the current trigger. */
+            uint32_t id;
+        };
+
+        struct Data :LocalEventData {
+            void disconnect(uint32_t _id) override;
+
+            /** \brief Remove the disconnected slots and append the ones connected while triggering. */
+            void flush();
+
+            std::vector<Slot> slots;
+            std::vector<Slot> connectedWhileTriggering;
+            uint32_t nextId = 1;
+            uint32_t connectionCount = 0;
+            uint32_t triggerDepth = 0;
+            bool hasDisconnectedSlots = false;
+
+            /** \brief Set when a callback destroys the event, released once the trigger returns. */
+            std::shared_ptr<Data> orphan;
+        };
+
+        std::shared_ptr<Data> mData;
+    };
+
+    template<typename _ReType, typename... _Args>
+    LocalEvent<_ReType(_Args...)>::~LocalEvent() {
+        if (mData->triggerDepth > 0)
+            mData->orphan = mData;
+    }
+
+    template<typename _ReType, typename... _Args>
+    LocalEventHandle LocalEvent<_ReType(_Args...)>::connect(Function _func) {
+        Data& data = *mData;
+        const uint32_t id = data.nextId++;
+        if (data.nextId == 0)
+            data.nextId = 1;
+
+        // Growing the array would move the callback being called
+        auto& slots = data.triggerDepth > 0 ? data.connectedWhileTriggering : data.slots;
+        slots.push_back(Slot{ std::move(_func), id });
+        ++data.connectionCount;
+
+        return LocalEventHandle(mData, id);
+    }
+
+    template<typename _ReType, typename... _Args>
+    void LocalEvent<_ReType(_Args...)>::trigger(_Args... _args) {
+        Data& data = *mData;
+        ++data.triggerDepth;
+
+        // Callbacks connected from now on are called starting with the next trigger
+        const size_t count = data.slots.size();
+        for (size_t i = 0; i < count && !data.orphan; ++i) {
+            const Slot& slot = data.slots[i];
+            if (slot.id != 0)
+                slot.func(_args...);
+        }
+
+        if (--data.triggerDepth > 0)
+            return;
+
+        if (data.orphan) {
+            // Last use of data, the event itself is gone
+            auto release = std::move(data.orphan);
+            return;
+        }
+        data.flush();
+    }
+
+    template<typename _ReType, typename... _Args>
+    void LocalEvent<_ReType(_Args...)>::clear() {
+        Data& data = *mData;
+        data.connectedWhileTriggering.clear();
+        data.connectionCount = 0;
+
+        if (data.triggerDepth == 0) {
+            data.slots.clear();
+            return;
+        }
+
+        for (auto& slot : data.slots)
+            slot.id = 0;
+        data.hasDisconnectedSlots = true;
+    }
+
+    template<typename _ReType, typename... _Args>
+    void LocalEvent<_ReType(_Args...)>::Data::disconnect(uint32_t _id) {
+        auto disable = [this, _id](std::vector<Slot>& _slots, bool _defer) {
+            for (auto it = _slots.begin(); it != _slots.end(); ++it) {
+                if (it->id != _id)
+                    continue;
+
+                if (_defer) {
+                    it->id = 0;
+                    hasDisconnectedSlots = true;
+                }
+                else {
+                    _slots.erase(it);
+                }
+                --connectionCount;
+                return true;
+            }
+            return false;
+        };
+
+        if (!disable(slots, triggerDepth > 0))
+            disable(connectedWhileTriggering, false);
+    }
+
+    template<typename _ReType, typename... _Args>
+    void LocalEvent<_ReType(_Args...)>::Data::flush() {
+        if (hasDisconnectedSlots) {
+            slots.erase(std::remove_if(slots.begin(), slots.end(), [](const Slot& _slot) { return _slot.id == 0; }), slots.end());
+            hasDisconnectedSlots = false;
+        }
+
+        if (!connectedWhileTriggering.empty()) {
+            for (auto& slot : connectedWhileTriggering)
+                slots.push_back(std::move(slot));
+            connectedWhileTriggering.clear();
+        }
+    }
+
+
+    template<typename _Ty>
+    class QueuedEvent;
+
+    /**
+     * \brief A LocalEvent any thread may post to.
+     *
+     *        Callbacks are connected and called on the owner thread. post() pushes a copy of the arguments to
+     *        a lock-free queue and dispatch() triggers the event once per post, in order.
+     */
+    template<typename... _Args>
+    class QueuedEvent<void(_Args...)> :public LocalEvent<void(_Args...)> {
+    public:
+        /** \brief Thread-safe. */
+        template<typename... _PostArgs>
+        void post(_PostArgs&&... _args) {
+            mQueue.push(std::forward<_PostArgs>(_args)...);
+        }
+
+        /**
+         * \brief Trigger the event for every post received so far, only call it on the owner thread.
+         * \return The amount of posts dispatched.
+         */
+        uint32_t dispatch() {
+            uint32_t count = 0;
+            while (auto args = mQueue.pop()) {
+                std::apply([this](auto&... _args) { this->trigger(_args...); }, *args);
+                ++count;
+            }
+            return count;
+        }
+
+    private:
+        MpscQueue<std::tuple<std::decay_t<_Args>...>> mQueue;
+    };
+}
+
+#endif
@@ -0,0 +1,116 @@
+#include "MxMappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <Windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace Mix {
+    MappedFile::MappedFile(MappedFile&& _other) noexcept {
+        swap(_other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& _other) noexcept {
+        if (this != &_other) {
+            close();
+            swap(_other);
+        }
+        return *this;
+    }
+
+    void MappedFile::swap(MappedFile& _other) noexcept {
+        std::swap(mData, _other.mData);
+        std::swap(mSize, _other.mSize);
+#ifdef _WIN32
+        std::swap(mFile, _other.mFile);
+        std::swap(mMapping, _other.mMapping);
+#endif
+    }
+
+#ifdef _WIN32
+    bool MappedFile::open(const std::filesystem::path& _path) {
+        close();
+
+        HANDLE file = CreateFileW(_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            CloseHandle(file);
+            return false;
+        }
+
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        mFile = file;
+        mMapping = mapping;
+        mData = static_cast<const uint8_t*>(view);
+        mSize = static_cast<size_t>(size.QuadPart);
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (mData)
+            UnmapViewOfFile(mData);
+        if (mMapping)
+            CloseHandle(mMapping);
+        if (mFile)
+            CloseHandle(mFile);
+        mData = nullptr;
+        mSize = 0;
+        mFile = nullptr;
+        mMapping = nullptr;
+    }
+#else
+    bool MappedFile::open(const std::filesystem::path& _path) {
+        close();
+
+        const int fd = ::open(_path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping keeps its own reference to the file
+        ::close(fd);
+        if (view == MAP_FAILED)
+            return false;
+
+        mData = static_cast<const uint8_t*>(view);
+        mSize = static_cast<size_t>(info.st_size);
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (mData)
+            munmap(const_cast<uint8_t*>(mData), mSize);
+        mData = nullptr;
+        mSize = 0;
+    }
+#endif
+}
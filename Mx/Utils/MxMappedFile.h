@@ -0,0 +1,56 @@
+#pragma once
+#ifndef MX_MAPPED_FILE_H_
+#define MX_MAPPED_FILE_H_
+
+#include <cstdint>
+#include <filesystem>
+
+namespace Mix {
+    /**
+     * \brief A read-only view of a whole file mapped into memory.
+     *
+     *        Pages are loaded by the OS on first access, so opening a file costs no copy and
+     *        no parsing. The view stays valid until the MappedFile is closed or destroyed.
+     */
+    class MappedFile {
+    public:
+        MappedFile() = default;
+
+        ~MappedFile() { close(); }
+
+        MappedFile(const MappedFile& _other) = delete;
+
+        MappedFile& operator=(const MappedFile& _other) = delete;
+
+        MappedFile(MappedFile&& _other) noexcept;
+
+        MappedFile& operator=(MappedFile&& _other) noexcept;
+
+        /**
+         * \brief Map the file at _path, the previously mapped file is closed.
+         * \return False if the file couldn't be opened or mapped.
+         */
+        bool open(const std::filesystem::path& _path);
+
+        void close();
+
+        bool isOpen() const { return mData != nullptr; }
+
+        const uint8_t* data() const { return mData; }
+
+        size_t size() const { return mSize; }
+
+    private:
+        void swap(MappedFile& _other) noexcept;
+
+        const uint8_t* mData = nullptr;
+        size_t mSize = 0;
+
+#ifdef _WIN32
+        void* mFile = nullptr;
+        void* mMapping = nullptr;
+#endif
+    };
+}
+
+#endif
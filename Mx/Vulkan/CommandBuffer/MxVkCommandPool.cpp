@@ -57,5 +57,9 @@ namespace Mix {
 		void CommandPool::free(const std::vector<vk::CommandBuffer>& _cmdBuffers) {
 			mDevice->getVkHandle().freeCommandBuffers(*mCommandPool, _cmdBuffers);
 		}
+
+		void CommandPool::reset() {
+			mDevice->getVkHandle().resetCommandPool(*mCommandPool, vk::CommandPoolResetFlags());
+		}
 	}
 }
@@ -40,6 +40,9 @@ namespace Mix {
 
 			void free(const std::vector<vk::CommandBuffer>& _cmdBuffers);
 
+			/** \brief Return every command buffer allocated from this pool to the initial state. */
+			void reset();
+
 		private:
 			vk::UniqueCommandPool mCommandPool;
 
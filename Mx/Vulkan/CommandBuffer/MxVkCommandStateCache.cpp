@@ -0,0 +1,119 @@
+#include "MxVkCommandStateCache.h"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace Mix {
+	namespace Vulkan {
+		CommandStats& CommandStats::operator+=(const CommandStats& _other) {
+			for (uint32_t i = 0; i < CommandCount; ++i) {
+				issued[i] += _other.issued[i];
+				filtered[i] += _other.filtered[i];
+			}
+			return *this;
+		}
+
+		uint32_t CommandStats::totalIssued() const {
+			return std::accumulate(issued.begin(), issued.end(), 0u);
+		}
+
+		uint32_t CommandStats::totalFiltered() const {
+			return std::accumulate(filtered.begin(), filtered.end(), 0u);
+		}
+
+		bool CommandStateCache::issue(const CommandStats::Command _command, const bool _redundant) {
+			if (_redundant) {
+				++mStats.filtered[_command];
+				return false;
+			}
+			++mStats.issued[_command];
+			return true;
+		}
+
+		void CommandStateCache::useLayout(const vk::PipelineLayout& _layout) {
+			if (_layout == mLayout)
+				return;
+
+			// Sets and push constants may be disturbed by an incompatible layout, don't assume anything
+			mLayout = _layout;
+			mDescriptorSets.fill(vk::DescriptorSet());
+			mPushConstantStages.fill(vk::ShaderStageFlags());
+		}
+
+		void CommandStateCache::bindPipeline(const vk::Pipeline& _pipeline) {
+			if (!issue(CommandStats::Pipeline, _pipeline == mPipeline))
+				return;
+
+			mCmd.bindPipeline(vk::PipelineBindPoint::eGraphics, _pipeline);
+			mPipeline = _pipeline;
+		}
+
+		void CommandStateCache::bindDescriptorSet(const vk::PipelineLayout& _layout, const uint32_t _set, const vk::DescriptorSet& _descriptorSet) {
+			const bool tracked = _set < MaxDescriptorSets;
+			if (!issue(CommandStats::DescriptorSet, tracked && _layout == mLayout && mDescriptorSets[_set] == _descriptorSet))
+				return;
+
+			mCmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, _layout, _set, _descriptorSet, nullptr);
+			useLayout(_layout);
+			if (tracked)
+				mDescriptorSets[_set] = _descriptorSet;
+		}
+
+		void CommandStateCache::bindVertexBuffer(const uint32_t _binding, const vk::Buffer& _buffer, const vk::DeviceSize _offset) {
+			const bool tracked = _binding < MaxVertexBindings;
+			if (!issue(CommandStats::VertexBuffer, tracked && mVertexBuffers[_binding] == std::make_pair(_buffer, _offset)))
+				return;
+
+			mCmd.bindVertexBuffers(_binding, _buffer, _offset);
+			if (tracked)
+				mVertexBuffers[_binding] = std::make_pair(_buffer, _offset);
+		}
+
+		void CommandStateCache::bindIndexBuffer(const vk::Buffer& _buffer, const vk::DeviceSize _offset, const vk::IndexType _indexType) {
+			if (!issue(CommandStats::IndexBuffer, _buffer && _buffer == mIndexBuffer && _offset == mIndexOffset && _indexType == mIndexType))
+				return;
+
+			mCmd.bindIndexBuffer(_buffer, _offset, _indexType);
+			mIndexBuffer = _buffer;
+			mIndexOffset = _offset;
+			mIndexType = _indexType;
+		}
+
+		void CommandStateCache::setViewport(const vk::Viewport& _viewport) {
+			if (!issue(CommandStats::Viewport, mViewport && *mViewport == _viewport))
+				return;
+
+			mCmd.setViewport(0, _viewport);
+			mViewport = _viewport;
+		}
+
+		void CommandStateCache::setScissor(const vk::Rect2D& _scissor) {
+			if (!issue(CommandStats::Scissor, mScissor && *mScissor == _scissor))
+				return;
+
+			mCmd.setScissor(0, _scissor);
+			mScissor = _scissor;
+		}
+
+		void CommandStateCache::pushConstants(const vk::PipelineLayout& _layout,
+											  const vk::ShaderStageFlags _stages,
+											  const uint32_t _offset,
+											  const uint32_t _size,
+											  const void* _data) {
+			const bool tracked = _offset + _size <= MaxPushConstantsSize;
+			const bool redundant = tracked && _layout == mLayout &&
+				std::all_of(mPushConstantStages.begin() + _offset, mPushConstantStages.begin() + _offset + _size,
+							[_stages](vk::ShaderStageFlags _byteStages) { return _byteStages == _stages; }) &&
+				std::memcmp(mPushConstants.data() + _offset, _data, _size) == 0;
+			if (!issue(CommandStats::PushConstants, redundant))
+				return;
+
+			mCmd.pushConstants(_layout, _stages, _offset, _size, _data);
+			useLayout(_layout);
+			if (tracked) {
+				std::memcpy(mPushConstants.data() + _offset, _data, _size);
+				std::fill(mPushConstantStages.begin() + _offset, mPushConstantStages.begin() + _offset + _size, _stages);
+			}
+		}
+	}
+}
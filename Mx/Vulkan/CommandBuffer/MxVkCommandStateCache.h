@@ -0,0 +1,111 @@
+#pragma once
+#ifndef MX_VK_COMMAND_STATE_CACHE_H_
+#define MX_VK_COMMAND_STATE_CACHE_H_
+
+#include <vulkan/vulkan.hpp>
+#include <array>
+#include <optional>
+
+namespace Mix {
+	namespace Vulkan {
+		/** \brief Amount of state commands issued and filtered, per kind of command. */
+		struct CommandStats {
+			enum Command {
+				Pipeline,
+				DescriptorSet,
+				VertexBuffer,
+				IndexBuffer,
+				Viewport,
+				Scissor,
+				PushConstants,
+				CommandCount
+			};
+
+			std::array<uint32_t, CommandCount> issued{};
+			std::array<uint32_t, CommandCount> filtered{};
+
+			CommandStats& operator+=(const CommandStats& _other);
+
+			uint32_t totalIssued() const;
+
+			uint32_t totalFiltered() const;
+		};
+
+		/**
+		 * \brief Graphics state commands recorded through a cache of the state bound to a command buffer.
+		 *
+		 *        A command setting the state already bound is dropped and counted in getStats(). Descriptor sets
+		 *        and push constants are tracked for one pipeline layout, using another layout forgets them.
+		 *        The cache starts empty, as a command buffer does, and only sees the commands recorded through it.
+		 */
+		class CommandStateCache {
+		public:
+			static constexpr uint32_t MaxDescriptorSets = 8;
+			static constexpr uint32_t MaxVertexBindings = 4;
+
+			/** \brief The minimum maxPushConstantsSize guaranteed by Vulkan, larger ranges are never filtered. */
+			static constexpr uint32_t MaxPushConstantsSize = 128;
+
+			explicit CommandStateCache(const vk::CommandBuffer& _cmd) :mCmd(_cmd) {}
+
+			const vk::CommandBuffer& get() const { return mCmd; }
+
+			const CommandStats& getStats() const { return mStats; }
+
+			void bindPipeline(const vk::Pipeline& _pipeline);
+
+			void bindDescriptorSet(const vk::PipelineLayout& _layout, uint32_t _set, const vk::DescriptorSet& _descriptorSet);
+
+			void bindVertexBuffer(uint32_t _binding, const vk::Buffer& _buffer, vk::DeviceSize _offset = 0);
+
+			void bindIndexBuffer(const vk::Buffer& _buffer, vk::DeviceSize _offset, vk::IndexType _indexType);
+
+			void setViewport(const vk::Viewport& _viewport);
+
+			void setScissor(const vk::Rect2D& _scissor);
+
+			void pushConstants(const vk::PipelineLayout& _layout,
+							   vk::ShaderStageFlags _stages,
+							   uint32_t _offset,
+							   uint32_t _size,
+							   const void* _data);
+
+			template<typename _Ty>
+			void pushConstants(const vk::PipelineLayout& _layout, vk::ShaderStageFlags _stages, uint32_t _offset, const _Ty& _value) {
+				pushConstants(_layout, _stages, _offset, sizeof(_Ty), &_value);
+			}
+
+			void drawIndexed(uint32_t _indexCount, uint32_t _instanceCount, uint32_t _firstIndex, int32_t _vertexOffset, uint32_t _firstInstance) {
+				mCmd.drawIndexed(_indexCount, _instanceCount, _firstIndex, _vertexOffset, _firstInstance);
+			}
+
+		private:
+			/** \brief Switch the tracked descriptor sets and push constants to _layout. */
+			void useLayout(const vk::PipelineLayout& _layout);
+
+			/** \brief Count a command, return true if it has to be recorded. */
+			bool issue(CommandStats::Command _command, bool _redundant);
+
+			vk::CommandBuffer mCmd;
+			CommandStats mStats;
+
+			vk::Pipeline mPipeline;
+			vk::PipelineLayout mLayout;
+			std::array<vk::DescriptorSet, MaxDescriptorSets> mDescriptorSets;
+			std::array<std::pair<vk::Buffer, vk::DeviceSize>, MaxVertexBindings> mVertexBuffers;
+
+			vk::Buffer mIndexBuffer;
+			vk::DeviceSize mIndexOffset = 0;
+			vk::IndexType mIndexType = vk::IndexType::eUint32;
+
+			std::optional<vk::Viewport> mViewport;
+			std::optional<vk::Rect2D> mScissor;
+
+			/** \brief Push constant bytes with the stages they were pushed to, no stage means unknown. */
+			std::array<uint8_t, MaxPushConstantsSize> mPushConstants{};
+			std::array<vk::ShaderStageFlags, MaxPushConstantsSize> mPushConstantStages{};
+		};
+	}
+}
+
+#endif
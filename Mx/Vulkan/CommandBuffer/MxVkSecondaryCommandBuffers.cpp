@@ -0,0 +1,61 @@
+#include "MxVkSecondaryCommandBuffers.h"
+#include "MxVkCommandPool.h"
+
+namespace Mix {
+	namespace Vulkan {
+		SecondaryCommandBuffers::SecondaryCommandBuffers(const std::shared_ptr<Device>& _device,
+														 const uint32_t _frameCount,
+														 const uint32_t _slotCount)
+			: mSlotCount(_slotCount) {
+			mSlots.resize(_frameCount * _slotCount);
+			for (auto& slot : mSlots) {
+				// The whole pool is reset each frame, its buffers are short-lived
+				slot.pool = std::make_unique<CommandPool>(_device, vk::QueueFlagBits::eGraphics, vk::CommandPoolCreateFlagBits::eTransient);
+				slot.cmd = slot.pool->allocate(vk::CommandBufferLevel::eSecondary);
+			}
+			mExecuteScratch.reserve(_slotCount);
+		}
+
+		SecondaryCommandBuffers::~SecondaryCommandBuffers() {
+			for (auto& slot : mSlots) {
+				if (slot.pool)
+					slot.pool->free(slot.cmd);
+			}
+		}
+
+		const vk::CommandBuffer& SecondaryCommandBuffers::begin(const uint32_t _frame,
+																const uint32_t _slot,
+																const vk::RenderPass& _renderPass,
+																const uint32_t _subpass,
+																const vk::Framebuffer& _framebuffer) {
+			Slot& slot = getSlot(_frame, _slot);
+			slot.pool->reset();
+
+			vk::CommandBufferInheritanceInfo inheritanceInfo;
+			inheritanceInfo.renderPass = _renderPass;
+			inheritanceInfo.subpass = _subpass;
+			inheritanceInfo.framebuffer = _framebuffer;
+
+			vk::CommandBufferBeginInfo beginInfo;
+			beginInfo.flags = vk::CommandBufferUsageFlagBits::eRenderPassContinue | vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+			beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+			slot.cmd.begin(beginInfo);
+			return slot.cmd;
+		}
+
+		void SecondaryCommandBuffers::end(const uint32_t _frame, const uint32_t _slot) {
+			getSlot(_frame, _slot).cmd.end();
+		}
+
+		void SecondaryCommandBuffers::execute(const vk::CommandBuffer& _primary, const uint32_t _frame, const std::vector<uint32_t>& _slots) {
+			if (_slots.empty())
+				return;
+
+			mExecuteScratch.clear();
+			for (auto slot : _slots)
+				mExecuteScratch.push_back(getSlot(_frame, slot).cmd);
+			_primary.executeCommands(mExecuteScratch);
+		}
+	}
+}
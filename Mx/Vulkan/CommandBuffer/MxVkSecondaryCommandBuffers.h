@@ -0,0 +1,59 @@
+#pragma once
+#ifndef MX_VK_SECONDARY_COMMAND_BUFFERS_H_
+#define MX_VK_SECONDARY_COMMAND_BUFFERS_H_
+
+#include "../../Utils/MxGeneralBase.hpp"
+#include <vulkan/vulkan.hpp>
+#include <memory>
+#include <vector>
+
+namespace Mix {
+	namespace Vulkan {
+		class Device;
+		class CommandPool;
+
+		/**
+		 * \brief Secondary command buffers recorded inside the render pass, executed in slot order by the primary one.
+		 *
+		 *        Every frame in flight has its own set of slots and every slot its own CommandPool, so different
+		 *        slots may be recorded on different threads without locking. A slot is recorded by one thread at a time.
+		 */
+		class SecondaryCommandBuffers final :public GeneralBase::NoCopyBase {
+		public:
+			SecondaryCommandBuffers(const std::shared_ptr<Device>& _device, uint32_t _frameCount, uint32_t _slotCount);
+
+			~SecondaryCommandBuffers();
+
+			uint32_t slotCount() const { return mSlotCount; }
+
+			/**
+			 * \brief Reset the pool of the slot and begin its command buffer.
+			 * \note  The primary command buffer of _frame must not be pending anymore.
+			 */
+			const vk::CommandBuffer& begin(uint32_t _frame,
+										   uint32_t _slot,
+										   const vk::RenderPass& _renderPass,
+										   uint32_t _subpass,
+										   const vk::Framebuffer& _framebuffer);
+
+			void end(uint32_t _frame, uint32_t _slot);
+
+			/** \brief Execute the slots of _frame listed in _slots, in that order. */
+			void execute(const vk::CommandBuffer& _primary, uint32_t _frame, const std::vector<uint32_t>& _slots);
+
+		private:
+			struct Slot {
+				std::unique_ptr<CommandPool> pool;
+				vk::CommandBuffer cmd;
+			};
+
+			Slot& getSlot(uint32_t _frame, uint32_t _slot) { return mSlots[_frame * mSlotCount + _slot]; }
+
+			uint32_t mSlotCount;
+			std::vector<Slot> mSlots;
+			std::vector<vk::CommandBuffer> mExecuteScratch;
+		};
+	}
+}
+
+#endif
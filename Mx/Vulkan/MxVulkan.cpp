@@ -96,10 +96,13 @@ namespace Mix {
             clearValues[0].color = std::array<float, 4>{0.2f, 0.2f, 0.2f, 1.0f};
             clearValues[1].depthStencil = vk::ClearDepthStencilValue(1.0f, 0);
 
+            // Draws are recorded in secondary command buffers, see Graphics::render()
             mRenderPass->beginRenderPass(mCurrCmd->get(),
                                          mFrameBuffers[mCurrFrame].get(),
                                          clearValues,
-                                         mSwapchain->extent());
+                                         mSwapchain->extent(),
+                                         { 0, 0 },
+                                         vk::SubpassContents::eSecondaryCommandBuffers);
         }
 
         void VulkanAPI::endRender() {
@@ -188,12 +188,20 @@ namespace Mix {
             PipelineKey key{ renderPassKey,_subpassIndex,_drawMode,_vertexInput->getId(),_depthTest,_depthWrite,_stencilTest };
 
             // A suitable graphice pipeline exists
+            {
+                std::shared_lock<std::shared_mutex> lock(mPipelineMutex);
+                auto it = mPipelineMap.find(key);
+                if (it != mPipelineMap.end())
+                    return it->second;
+            }
+
+            // No suitable graphice pipeline
+            // Create a new one, createPipeline() writes to mPipelineStateData
+            std::unique_lock<std::shared_mutex> lock(mPipelineMutex);
             auto it = mPipelineMap.find(key);
             if (it != mPipelineMap.end())
                 return it->second;
 
-            // No suitable graphice pipeline
-            // Create a new one
             auto newPipeline = createPipeline(_renderPass, _subpassIndex, _drawMode, _vertexInput, _depthTest, _depthWrite, _stencilTest);
             mPipelineMap[key] = newPipeline;
             return newPipeline;
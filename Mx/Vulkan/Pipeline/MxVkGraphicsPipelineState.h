@@ -2,6 +2,7 @@
 #ifndef MX_VK_GRAPHICS_PIPELINE_STATE_H_
 #define MX_VK_GRAPHICS_PIPELINE_STATE_H_
 #include <map>
+#include <shared_mutex>
 #include <vulkan/vulkan.hpp>
 #include "../../Utils/MxArrayProxy.h"
 #include "../../Definitions/MxCommonEnum.h"
@@ -49,6 +50,7 @@ namespace Mix {
 
             const vk::PipelineLayout& getPipelineLayout() const;
 
+            /** \brief Thread-safe, a missing Pipeline is created by the first thread asking for it. */
             std::shared_ptr<Pipeline> getPipeline(const std::shared_ptr<RenderPass>& _renderPass,
                                                   uint32_t _subpassIndex,
                                                   const std::shared_ptr<VertexInput>& _vertexInput,
@@ -104,6 +106,7 @@ namespace Mix {
             std::shared_ptr<VertexDeclaration> mVertexDecl;
             std::vector<std::shared_ptr<ShaderModule>> mShaderModules;
             std::unordered_map<PipelineKey, std::shared_ptr<Pipeline>, PipelineKey::Hasher> mPipelineMap;
+            std::shared_mutex mPipelineMutex;
 
 
             std::shared_ptr<Pipeline> createPipeline(const std::shared_ptr<RenderPass>& _renderPass,
@@ -126,6 +126,14 @@ namespace Mix {
 		std::shared_ptr<VertexInput> VertexInputManager::getVertexInput(const VertexDeclaration& _src, const VertexDeclaration& _dst) {
 			VertexInputKey key(_src.hash(), _dst.hash());
 
+			{
+				std::shared_lock<std::shared_mutex> lock(mMutex);
+				auto it = mVertexInputMap.find(key);
+				if (it != mVertexInputMap.end())
+					return it->second;
+			}
+
+			std::unique_lock<std::shared_mutex> lock(mMutex);
 			auto it = mVertexInputMap.find(key);
 			if (it == mVertexInputMap.end()) {
 				return addNew(_src, _dst);
@@ -135,6 +143,7 @@ namespace Mix {
 		}
 
 		std::shared_ptr<VertexInput> VertexInputManager::addNew(const VertexDeclaration& _src, const VertexDeclaration& _dst) {
+			// Called with the lock held
 			if (!_src.isCompatible(_dst))
 				return nullptr;
 			auto result = std::shared_ptr<VertexInput>(new VertexInput(++mNextId, _src, _dst));
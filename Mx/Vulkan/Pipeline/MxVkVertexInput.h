@@ -2,6 +2,7 @@
 #ifndef MX_VK_VERTEX_INPUT_H_
 #define MX_VK_VERTEX_INPUT_H_
 
+#include <shared_mutex>
 #include <vector>
 #include <vulkan/vulkan.hpp>
 #include "../../Utils/MxGeneralBase.hpp"
@@ -69,6 +70,7 @@ namespace Mix {
 
 			VertexInputManager& operator=(VertexInputManager&& _other) noexcept;
 
+			/** \brief Thread-safe, command buffers are recorded on several threads. */
 			std::shared_ptr<VertexInput> getVertexInput(const VertexDeclaration& _src, const VertexDeclaration& _dst);
 
 		private:
@@ -76,6 +78,7 @@ namespace Mix {
 
 			uint32_t mNextId = 0;
 			std::unordered_map<VertexInputKey, std::shared_ptr<VertexInput>, VertexInputKey::Hasher> mVertexInputMap;
+			std::shared_mutex mMutex;
 		};
 	}
 }
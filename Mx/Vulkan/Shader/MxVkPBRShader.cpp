@@ -50,12 +50,12 @@ namespace Mix {
         PBRShader::~PBRShader() {
         }
 
-        void PBRShader::render(RenderElement& _element) {
-            beginElement(_element);
+        void PBRShader::render(DrawContext& _context, RenderElement& _element) {
+            beginElement(_context, _element);
 
-            choosePipeline(*_element.material, *_element.mesh, _element.submesh);
-            setMaterail(*_element.material);
-            DrawMesh(*mCurrCmd, *_element.mesh, _element.submesh);
+            choosePipeline(_context, *_element.material, *_element.mesh, _element.submesh);
+            setMaterail(_context, *_element.material);
+            DrawMesh(_context.cmd, *_element.mesh, _element.submesh, _element.submeshCount);
 
             endElement();
         }
@@ -69,13 +69,8 @@ namespace Mix {
             mRenderParam.scaleIBLAmbient = _shader.getGlobalFloat("scaleIBLAmbient").value();
         }
 
-        void PBRShader::beginRender(const Camera& _camera) {
+        void PBRShader::beginFrame(const Camera& _camera) {
             mCurrFrame = mVulkan->getCurrFrame();
-            mCurrCmd = &mVulkan->getCurrDrawCmd();
-            mCurrVertexInput = nullptr;
-            mCurrPipeline = nullptr;
-
-            auto& cmd = mVulkan->getCurrDrawCmd();
 
             // update Camera
             setCamera(_camera);
@@ -84,7 +79,15 @@ namespace Mix {
             mRenderParamUbo[mCurrFrame].setData(&mRenderParam, sizeof(mRenderParam));
         }
 
-        void PBRShader::endRender() {
+        void PBRShader::beginRender(DrawContext& _context) {
+            _context.vertexInput = nullptr;
+            _context.pipeline = nullptr;
+
+            _context.cmd.setViewport(mViewport);
+            _context.cmd.setScissor(mScissor);
+        }
+
+        void PBRShader::endRender(DrawContext& _context) {
         }
 
         uint32_t PBRShader::newMaterial() {
@@ -106,54 +109,49 @@ namespace Mix {
             ubo.projMat[1][1] *= -1.0f;
             mCameraUbo[mCurrFrame].setData(&ubo, sizeof(ubo));
 
-            vk::Viewport viewport(
+            mViewport = vk::Viewport(
                 0.0f, 0.0f,
                 _camera.getExtent().x, _camera.getExtent().y,
                 0.0f, 1.0f
             );
 
-            vk::Rect2D scissor(
+            mScissor = vk::Rect2D(
                 { 0, 0 },
                 vk::Extent2D(_camera.getExtent().x, _camera.getExtent().y)
             );
-
-            mCurrCmd->get().setViewport(0, viewport);
-            mCurrCmd->get().setScissor(0, scissor);
         }
 
-        void PBRShader::beginElement(const RenderElement& _element) {
-            mCurrCmd->get().pushConstants<Matrix4>(mGraphicsPipelineState->getPipelineLayout(),
-                                                   vk::ShaderStageFlagBits::eVertex,
-                                                   0,
-                                                   _element.transform->localToWorldMatrix());
-            mCurrCmd->get().bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                                               mGraphicsPipelineState->getPipelineLayout(),
-                                               0,
-                                               mStaticDescriptorSets[mCurrFrame].get(),
-                                               nullptr);
+        void PBRShader::beginElement(DrawContext& _context, const RenderElement& _element) {
+            _context.cmd.pushConstants<Matrix4>(mGraphicsPipelineState->getPipelineLayout(),
+                                                vk::ShaderStageFlagBits::eVertex,
+                                                0,
+                                                _element.transform ? _element.transform->cachedLocalToWorldMatrix() : Matrix4::Identity);
+            _context.cmd.bindDescriptorSet(mGraphicsPipelineState->getPipelineLayout(),
+                                           0,
+                                           mStaticDescriptorSets[_context.frame].get());
         }
 
         void PBRShader::endElement() {
         }
 
-        bool PBRShader::choosePipeline(const Material& _material, const Mesh& _mesh, uint32_t _submesh) {
+        bool PBRShader::choosePipeline(DrawContext& _context, const Material& _material, const Mesh& _mesh, uint32_t _submesh) {
             bool depthWrite = _material.getRenderType() != RenderType::Transparent;
 
             auto newVertexInput = mVulkan->getVertexInputManager().getVertexInput(*_mesh.getVertexDeclaration(), *mGraphicsPipelineState->getVertexDeclaration());
             if (newVertexInput == nullptr) // This mesh is not compatiple with this pipeline
                 return false;
-            if (newVertexInput != mCurrVertexInput) {
+            if (newVertexInput != _context.vertexInput) {
                 auto newPipeline = mGraphicsPipelineState->getPipeline(mVulkan->getRenderPass(), 0, newVertexInput, _mesh.getTopology(_submesh), true, depthWrite);
-                if (newPipeline != mCurrPipeline) {
-                    mCurrCmd->get().bindPipeline(vk::PipelineBindPoint::eGraphics, newPipeline->get());
-                    mCurrPipeline = newPipeline;
+                if (newPipeline != _context.pipeline) {
+                    _context.cmd.bindPipeline(newPipeline->get());
+                    _context.pipeline = newPipeline;
                 }
-                mCurrVertexInput = newVertexInput;
+                _context.vertexInput = newVertexInput;
             }
             return true;
         }
 
-        void PBRShader::updateTexture(Material& _material) {
+        void PBRShader::prepareMaterial(Material& _material) {
             if (!_material._getChangedList().empty()) {
                 std::vector<WriteDescriptorSet> writes;
                 static std::string texNames[] = {
@@ -181,9 +179,7 @@ namespace Mix {
             _material._updated();
         }
 
-        void PBRShader::setMaterail(Material& _material) {
-            updateTexture(_material);
-
+        void PBRShader::setMaterail(DrawContext& _context, Material& _material) {
             MaterialParam param;
             param.baseColorFactor = _material.getVector("baseColorFactor").value();
             param.emissiveFactor = _material.getVector("emissiveFactor").value();
@@ -200,13 +196,11 @@ namespace Mix {
             param.alphaMask = _material.getFloat("alphaMask").value();
             param.alphaMaskCutoff = _material.getFloat("alphaMaskCutoff").value();
 
-            mCurrCmd->get().pushConstants<MaterialParam>(mGraphicsPipelineState->getPipelineLayout(), vk::ShaderStageFlagBits::eFragment, sizeof(Matrix4), param);
+            _context.cmd.pushConstants<MaterialParam>(mGraphicsPipelineState->getPipelineLayout(), vk::ShaderStageFlagBits::eFragment, sizeof(Matrix4), param);
 
-            mCurrCmd->get().bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                                               mCurrPipeline->pipelineLayout(),
-                                               1,
-                                               mMaterialDescs[0][_material._getMaterialId()].get(),
-                                               nullptr);
+            _context.cmd.bindDescriptorSet(_context.pipeline->pipelineLayout(),
+                                           1,
+                                           mMaterialDescs[0][_material._getMaterialId()].get());
         }
 
         void PBRShader::buildDescriptorSetLayout() {
@@ -1,18 +1,25 @@
 #include "../../Graphics/Mesh/MxMesh.h"
 #include "MxVkShaderBase.h"
-#include "../CommandBuffer/MxVkCommanddBufferHandle.h"
 
 namespace Mix {
-	void Vulkan::ShaderBase::DrawMesh(CommandBufferHandle& _cmd, const Mesh& _mesh, uint32_t _submesh) {
-		_cmd.get().bindVertexBuffers(0, _mesh.mVertexBuffer->get(), { 0 });
-		_cmd.get().bindIndexBuffer(_mesh.mIndexBuffer->get(),
-								   0,
-								   _mesh.mIndexFormat == IndexFormat::UInt16 ? vk::IndexType::eUint16 : vk::IndexType::eUint32);;
+	void Vulkan::ShaderBase::renderInstanced(DrawContext& _context, RenderElement* const* _elements, uint32_t _count) {
+		for (uint32_t i = 0; i < _count; ++i)
+			render(_context, *_elements[i]);
+	}
+
+	void Vulkan::ShaderBase::DrawMesh(CommandStateCache& _cmd, const Mesh& _mesh, uint32_t _submesh, uint32_t _submeshCount, uint32_t _instanceCount, uint32_t _firstInstance) {
+		const auto& first = _mesh.mSubMeshes[_submesh];
+		const auto& last = _mesh.mSubMeshes[_submesh + _submeshCount - 1];
+
+		_cmd.bindVertexBuffer(0, _mesh.mVertexBuffer->get());
+		_cmd.bindIndexBuffer(_mesh.mIndexBuffer->get(),
+							 0,
+							 _mesh.mIndexFormat == IndexFormat::UInt16 ? vk::IndexType::eUint16 : vk::IndexType::eUint32);;
 
-		_cmd.get().drawIndexed(_mesh.mSubMeshes[_submesh].indexCount,
-							   1,
-							   _mesh.mSubMeshes[_submesh].firstIndex,
-							   _mesh.mSubMeshes[_submesh].baseVertex,
-							   0);
+		_cmd.drawIndexed(last.firstIndex + last.indexCount - first.firstIndex,
+						 _instanceCount,
+						 first.firstIndex,
+						 first.baseVertex,
+						 _firstInstance);
 	}
 }
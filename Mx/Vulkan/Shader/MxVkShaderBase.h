@@ -5,25 +5,57 @@
 #include "../../Utils/MxGeneralBase.hpp"
 #include "../../Graphics/MxMaterial.h"
 #include "../../Utils/MxArrayProxy.h"
+#include "../CommandBuffer/MxVkCommandStateCache.h"
 
 namespace Mix {
     class Camera;
     class Mesh;
 
     namespace Vulkan {
-        class CommandBufferHandle;
+        class Pipeline;
+        class VertexInput;
+
+        /** \brief State of one command buffer being recorded, a shader may record into several at once. */
+        struct DrawContext {
+            DrawContext(const vk::CommandBuffer& _cmd, uint32_t _frame) :cmd(_cmd), frame(_frame) {}
+
+            /** \brief Drops the state commands that would not change anything. */
+            CommandStateCache cmd;
+            uint32_t frame;
+            std::shared_ptr<VertexInput> vertexInput;
+            std::shared_ptr<Pipeline> pipeline;
+        };
 
+        /**
+         * \brief A shader records draws of RenderElements into command buffers.
+         *
+         *        beginFrame() and prepareMaterial() run on the main thread before any recording. The other
+         *        render functions may run on several threads at once, each with its own DrawContext, so they
+         *        must only read the state of the shader.
+         */
         class ShaderBase : public GeneralBase::NoCopyBase {
         public:
             ShaderBase(VulkanAPI* _vulkan) :mVulkan(_vulkan) {}
 
             virtual ~ShaderBase() = default;
 
-            virtual void beginRender(const Camera& _camera) = 0;
+            /** \brief Upload the per frame data, called once per frame after VulkanAPI::beginRender(). */
+            virtual void beginFrame(const Camera& _camera) = 0;
+
+            /** \brief Apply the changes made to _material since it was last drawn. */
+            virtual void prepareMaterial(Material& _material) = 0;
+
+            virtual void beginRender(DrawContext& _context) = 0;
+
+            virtual void render(DrawContext& _context, RenderElement& _element) = 0;
 
-            virtual void render(RenderElement& _element) = 0;
+            /**
+             * \brief Draw _count elements sharing their Mesh, submesh and Material, each with its own transform.
+             *        The default draws them one by one.
+             */
+            virtual void renderInstanced(DrawContext& _context, RenderElement* const* _elements, uint32_t _count);
 
-            virtual void endRender() = 0;
+            virtual void endRender(DrawContext& _context) = 0;
 
             virtual void update(const Shader& _shader) = 0;
 
@@ -40,7 +72,8 @@ namespace Mix {
             MaterialPropertySet mMaterialPropertySet;
             MaterialPropertySet mShaderPropertySet;
 
-            static void DrawMesh(CommandBufferHandle& _cmd, const Mesh& _mesh, uint32_t _submesh);
+            /** \brief Draw _submeshCount submeshes starting at _submesh in one call, they must be contiguous and share their base vertex. */
+            static void DrawMesh(CommandStateCache& _cmd, const Mesh& _mesh, uint32_t _submesh, uint32_t _submeshCount = 1, uint32_t _instanceCount = 1, uint32_t _firstInstance = 0);
         };
     }
 }
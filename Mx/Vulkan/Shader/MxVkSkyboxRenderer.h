@@ -27,13 +27,17 @@ namespace Mix {
 
             ~SkyboxShader() override;
 
-            void render(RenderElement& _element) override;
+            void beginFrame(const Camera& _camera) override;
 
-            void update(const Shader& _shader) override;
+            void prepareMaterial(Material& _material) override;
+
+            void beginRender(DrawContext& _context) override;
 
-            void beginRender(const Camera& _camera) override;
+            void render(DrawContext& _context, RenderElement& _element) override;
 
-            void endRender() override;
+            void endRender(DrawContext& _context) override;
+
+            void update(const Shader& _shader) override;
 
             uint32_t newMaterial() override;
 
@@ -50,15 +54,13 @@ namespace Mix {
 
             void setCamera(const Camera& _camera);
 
-            void beginElement(const RenderElement& _element);
+            void beginElement(DrawContext& _context, const RenderElement& _element);
 
             void endElement();
 
-            bool choosePipeline(const Material& _material, const Mesh& _mesh, uint32_t _submesh);
-
-            void updateTexture(Material& _material);
+            bool choosePipeline(DrawContext& _context, const Material& _material, const Mesh& _mesh, uint32_t _submesh);
 
-            void setMaterail(Material& _material);
+            void setMaterail(DrawContext& _context, Material& _material);
 
             void loadGlobalTexture();
 
@@ -108,10 +110,9 @@ namespace Mix {
             std::deque<uint32_t> mUnusedId;
 
             // Frame rendering info
-            std::shared_ptr<VertexInput> mCurrVertexInput;
-            std::shared_ptr<Pipeline> mCurrPipeline;
             uint32_t mCurrFrame = 0;
-            CommandBufferHandle* mCurrCmd;
+            vk::Viewport mViewport;
+            vk::Rect2D mScissor;
         };
     }
 }
@@ -26,6 +26,7 @@ namespace Mix {
             //mDynamicUniform.reserve(imageCount);
             // mTestDynamic.reserve(imageCount);
             mCameraUniforms.reserve(imageCount);
+            mInstanceBuffers.reserve(imageCount);
 
             for (size_t i = 0; i < imageCount; ++i) {
                 /*mDynamicUniform.emplace_back(mVulkan->getAllocator(),
@@ -37,6 +38,12 @@ namespace Mix {
                                              vk::MemoryPropertyFlagBits::eHostVisible |
                                              vk::MemoryPropertyFlagBits::eHostCoherent,
                                              sizeof(Uniform::CameraUniform));
+
+                mInstanceBuffers.emplace_back(mVulkan->getAllocator(),
+                                              vk::BufferUsageFlagBits::eStorageBuffer,
+                                              vk::MemoryPropertyFlagBits::eHostVisible |
+                                              vk::MemoryPropertyFlagBits::eHostCoherent,
+                                              MaxInstanceCount * sizeof(Matrix4));
             }
 
             buildDescriptorSetLayout();
@@ -48,19 +55,24 @@ namespace Mix {
         StandardShader::~StandardShader() {
         }
 
-        void StandardShader::beginRender(const Camera& _camera) {
+        void StandardShader::beginFrame(const Camera& _camera) {
             mCurrFrame = mVulkan->getCurrFrame();
-            mCurrCmd = &mVulkan->getCurrDrawCmd();
-            mCurrVertexInput = nullptr;
-            mCurrPipeline = nullptr;
-
-            auto& cmd = mVulkan->getCurrDrawCmd();
+            mInstanceCursor.store(1, std::memory_order_relaxed);
 
             // update Camera
             setCamera(_camera);
         }
 
-        void StandardShader::endRender() {
+        void StandardShader::beginRender(DrawContext& _context) {
+            _context.vertexInput = nullptr;
+            _context.pipeline = nullptr;
+
+            // Dynamic state isn't inherited by secondary command buffers
+            _context.cmd.setViewport(mViewport);
+            _context.cmd.setScissor(mScissor);
+        }
+
+        void StandardShader::endRender(DrawContext& _context) {
             // mDynamicUniform[mCurrFrame].reset();
         }
 
@@ -73,55 +85,50 @@ namespace Mix {
             ubo.projMat[1][1] *= -1.0f;
             mCameraUniforms[mCurrFrame].setData(&ubo, sizeof(ubo));
 
-            vk::Viewport viewport(
+            mViewport = vk::Viewport(
                 0.0f, 0.0f,
                 _camera.getExtent().x, _camera.getExtent().y,
                 0.0f, 1.0f
             );
 
-            vk::Rect2D scissor(
+            mScissor = vk::Rect2D(
                 { 0, 0 },
                 vk::Extent2D(_camera.getExtent().x, _camera.getExtent().y)
             );
-
-            mCurrCmd->get().setViewport(0, viewport);
-            mCurrCmd->get().setScissor(0, scissor);
         }
 
-        void StandardShader::beginElement(const RenderElement& _element) {
+        void StandardShader::beginElement(DrawContext& _context, const RenderElement& _element) {
             //Uniform::MeshUniform uniform;
             //uniform.modelMat = _renderer.transform->localToWorldMatrix();
             //mDynamicUniform[mCurrFrame].pushBack(&uniform, sizeof uniform);
-            mCurrCmd->get().pushConstants<Matrix4>(mGraphicsPipelineState->getPipelineLayout(), vk::ShaderStageFlagBits::eVertex, 0, _element.transform->localToWorldMatrix());
-            mCurrCmd->get().bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                                               mGraphicsPipelineState->getPipelineLayout(),
-                                               0,
-                                               mStaticDescriptorSets[mCurrFrame].get(),
-                                               nullptr);
+            _context.cmd.pushConstants<Matrix4>(mGraphicsPipelineState->getPipelineLayout(), vk::ShaderStageFlagBits::eVertex, 0, _element.transform ? _element.transform->cachedLocalToWorldMatrix() : Matrix4::Identity);
+            _context.cmd.bindDescriptorSet(mGraphicsPipelineState->getPipelineLayout(),
+                                           0,
+                                           mStaticDescriptorSets[_context.frame].get());
         }
 
         void StandardShader::endElement() {
             // mDynamicUniform[mCurrFrame].next();
         }
 
-        bool StandardShader::choosePipeline(const Material& _material, const Mesh& _mesh, uint32_t _submesh) {
+        bool StandardShader::choosePipeline(DrawContext& _context, const Material& _material, const Mesh& _mesh, uint32_t _submesh) {
             bool depthWrite = _material.getRenderType() != RenderType::Transparent;
 
             auto newVertexInput = mVulkan->getVertexInputManager().getVertexInput(*_mesh.getVertexDeclaration(), *mGraphicsPipelineState->getVertexDeclaration());
             if (newVertexInput == nullptr) // This mesh is not compatiple with this pipeline
                 return false;
-            if (newVertexInput != mCurrVertexInput) {
+            if (newVertexInput != _context.vertexInput) {
                 auto newPipeline = mGraphicsPipelineState->getPipeline(mVulkan->getRenderPass(), 0, newVertexInput, _mesh.getTopology(_submesh), true, depthWrite);
-                if (newPipeline != mCurrPipeline) {
-                    mCurrCmd->get().bindPipeline(vk::PipelineBindPoint::eGraphics, newPipeline->get());
-                    mCurrPipeline = newPipeline;
+                if (newPipeline != _context.pipeline) {
+                    _context.cmd.bindPipeline(newPipeline->get());
+                    _context.pipeline = newPipeline;
                 }
-                mCurrVertexInput = newVertexInput;
+                _context.vertexInput = newVertexInput;
             }
             return true;
         }
 
-        void StandardShader::updateMaterial(Material& _material) {
+        void StandardShader::prepareMaterial(Material& _material) {
             if (!_material._getChangedList().empty()) {
                 std::vector<WriteDescriptorSet> writes;
                 for (auto& name : _material._getChangedList()) {
@@ -134,20 +141,18 @@ namespace Mix {
             _material._updated();
         }
 
-        void StandardShader::setMaterail(Material& _material) {
-            updateMaterial(_material);
-            mCurrCmd->get().bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                                               mCurrPipeline->pipelineLayout(), 1,
-                                               mMaterialDescs[0][_material._getMaterialId()].get(),
-                                               nullptr);
+        void StandardShader::setMaterail(DrawContext& _context, Material& _material) {
+            _context.cmd.bindDescriptorSet(_context.pipeline->pipelineLayout(),
+                                           1,
+                                           mMaterialDescs[0][_material._getMaterialId()].get());
         }
 
-        void StandardShader::render(RenderElement& _element) {
-            beginElement(_element);
+        void StandardShader::render(DrawContext& _context, RenderElement& _element) {
+            beginElement(_context, _element);
 
-            choosePipeline(*_element.material, *_element.mesh, _element.submesh);
-            setMaterail(*_element.material);
-            DrawMesh(*mCurrCmd, *_element.mesh, _element.submesh);
+            choosePipeline(_context, *_element.material, *_element.mesh, _element.submesh);
+            setMaterail(_context, *_element.material);
+            DrawMesh(_context.cmd, *_element.mesh, _element.submesh, _element.submeshCount);
 
             endElement();
         // Test Gui
@@ -225,6 +230,30 @@ namespace Mix {
         //}
         }
 
+        void StandardShader::renderInstanced(DrawContext& _context, RenderElement* const* _elements, uint32_t _count) {
+            // Several threads may record runs at once, each one reserves its own slots
+            const uint32_t firstInstance = _count < 2 ? MaxInstanceCount : mInstanceCursor.fetch_add(_count, std::memory_order_relaxed);
+
+            // Runs that no longer fit this frame are drawn one by one
+            if (firstInstance + _count > MaxInstanceCount) {
+                ShaderBase::renderInstanced(_context, _elements, _count);
+                return;
+            }
+
+            auto matrices = static_cast<Matrix4*>(mInstanceBuffers[_context.frame].rawPtr()) + firstInstance;
+            for (uint32_t i = 0; i < _count; ++i)
+                matrices[i] = _elements[i]->transform->cachedLocalToWorldMatrix();
+
+            RenderElement& element = *_elements[0];
+            beginElement(_context, element);
+
+            choosePipeline(_context, *element.material, *element.mesh, element.submesh);
+            setMaterail(_context, *element.material);
+            DrawMesh(_context.cmd, *element.mesh, element.submesh, element.submeshCount, _count, firstInstance);
+
+            endElement();
+        }
+
         void StandardShader::update(const Shader& _shader) {
         }
 
@@ -243,6 +272,7 @@ namespace Mix {
 
             mDescriptorPool = std::make_shared<DescriptorPool>(mDevice);
             mDescriptorPool->addPoolSize(vk::DescriptorType::eUniformBuffer, imageCount);
+            mDescriptorPool->addPoolSize(vk::DescriptorType::eStorageBuffer, imageCount);
             // mDescriptorPool->addPoolSize(vk::DescriptorType::eUniformBufferDynamic, imageCount);
             mDescriptorPool->addPoolSize(vk::DescriptorType::eCombinedImageSampler, 1 * mDefaultMaterialCount * imageCount);
             mDescriptorPool->create((mDefaultMaterialCount + 1)*imageCount);
@@ -252,8 +282,9 @@ namespace Mix {
 
             // Create descriptor sets
             for (uint32_t i = 0; i < imageCount; ++i) {
-                std::array<WriteDescriptorSet, 1> descriptorWrites = {
+                std::array<WriteDescriptorSet, 2> descriptorWrites = {
                     mCameraUniforms[i].getWriteDescriptor(0, vk::DescriptorType::eUniformBuffer),
+                    mInstanceBuffers[i].getWriteDescriptor(1, vk::DescriptorType::eStorageBuffer),
                     // mDynamicUniform[i].getWriteDescriptor(1)
                 };
 
@@ -335,7 +366,8 @@ namespace Mix {
             mStaticParamDescriptorSetLayout = std::make_shared<DescriptorSetLayout>(mDevice);
             mStaticParamDescriptorSetLayout->setBindings(
                 {
-                    {0,vk::DescriptorType::eUniformBuffer,1,vk::ShaderStageFlagBits::eVertex}
+                    {0,vk::DescriptorType::eUniformBuffer,1,vk::ShaderStageFlagBits::eVertex},
+                    {1,vk::DescriptorType::eStorageBuffer,1,vk::ShaderStageFlagBits::eVertex}
                 }
             );
             mStaticParamDescriptorSetLayout->create();
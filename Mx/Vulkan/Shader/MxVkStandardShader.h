@@ -6,6 +6,7 @@
 #include "../Buffers/MxVkUniformBuffer.h"
 #include "../FrameBuffer/MxVkFramebuffer.h"
 #include "../Descriptor/MxVkDescriptorSet.h"
+#include <atomic>
 #include <deque>
 #include "../Pipeline/MxVkGraphicsPipelineState.h"
 
@@ -29,13 +30,19 @@ namespace Mix {
 
             ~StandardShader() override;
 
-            void render(RenderElement& _element) override;
+            void beginFrame(const Camera& _camera) override;
 
-            void update(const Shader& _shader) override;
+            void prepareMaterial(Material& _material) override;
+
+            void beginRender(DrawContext& _context) override;
 
-            void beginRender(const Camera& _camera) override;
+            void render(DrawContext& _context, RenderElement& _element) override;
 
-            void endRender() override;
+            void renderInstanced(DrawContext& _context, RenderElement* const* _elements, uint32_t _count) override;
+
+            void endRender(DrawContext& _context) override;
+
+            void update(const Shader& _shader) override;
 
             uint32_t newMaterial() override;
 
@@ -44,15 +51,13 @@ namespace Mix {
         private:
             void setCamera(const Camera& _camera);
 
-            void beginElement(const RenderElement& _element);
+            void beginElement(DrawContext& _context, const RenderElement& _element);
 
             void endElement();
 
-            bool choosePipeline(const Material& _material, const Mesh& _mesh, uint32_t _submesh);
-
-            void updateMaterial(Material& _material);
+            bool choosePipeline(DrawContext& _context, const Material& _material, const Mesh& _mesh, uint32_t _submesh);
 
-            void setMaterail(Material& _material);
+            void setMaterail(DrawContext& _context, Material& _material);
 
 
             std::shared_ptr<Device> mDevice;
@@ -64,6 +69,14 @@ namespace Mix {
             std::shared_ptr<DescriptorPool> mDescriptorPool;
             std::vector<DescriptorSet> mStaticDescriptorSets;
             std::vector<Buffer> mCameraUniforms;
+
+            /**
+             * \brief Model matrices of the instanced draws, one buffer per frame. Slot 0 is never written, a draw
+             *        whose first instance is 0 uses the matrix in the push constant instead.
+             */
+            std::vector<Buffer> mInstanceBuffers;
+            std::atomic<uint32_t> mInstanceCursor{ 1 };
+            static constexpr uint32_t MaxInstanceCount = 16384;
             std::vector<DynamicUniformBuffer> mDynamicUniform;
 
             uint32_t mDefaultMaterialCount = 100;
@@ -85,10 +98,9 @@ namespace Mix {
             void buildPropertyBlock();
 
             // Frame rendering info
-            std::shared_ptr<VertexInput> mCurrVertexInput;
-            std::shared_ptr<Pipeline> mCurrPipeline;
             uint32_t mCurrFrame = 0;
-            CommandBufferHandle* mCurrCmd;
+            vk::Viewport mViewport;
+            vk::Rect2D mScissor;
         };
     }
 }
@@ -61,7 +61,7 @@ namespace Mix {
             }
         }
 
-        void Mix::Vulkan::UIRenderer::render(GUI::UIRenderData& _renderData) {
+        void Mix::Vulkan::UIRenderer::render(CommandStateCache& _cmd, GUI::UIRenderData& _renderData) {
             if (_renderData.drawData->CmdListsCount > 0) {
                 mCurrFrame = mVulkan->getSwapchain()->getCurrFrame();
 
@@ -70,21 +70,18 @@ namespace Mix {
                 updateTexture(_renderData);
 
                 // Draw
-                auto& cmd = mVulkan->getCurrDrawCmd();
-                cmd.get().bindPipeline(vk::PipelineBindPoint::eGraphics, mPipeline->get());
-                cmd.get().bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                                             mPipeline->pipelineLayout(),
-                                             0,
-                                             mDescriptorSets[0].get(),
-                                             nullptr);
-                cmd.get().bindVertexBuffers(0, mVertexBuffers[mCurrFrame]->get(), { 0 });
-                cmd.get().bindIndexBuffer(mIndexBuffers[mCurrFrame]->get(), 0,
-                                          VulkanUtils::GetIndexType(_renderData.indexFormat));
-
-                cmd.get().pushConstants(mPipeline->pipelineLayout(), vk::ShaderStageFlagBits::eVertex, 0,
-                                        sizeof(Vector2f), _renderData.scale.linear);
-                cmd.get().pushConstants(mPipeline->pipelineLayout(), vk::ShaderStageFlagBits::eVertex,
-                                        sizeof(Vector2f), sizeof(Vector2f), _renderData.translate.linear);
+                _cmd.bindPipeline(mPipeline->get());
+                _cmd.bindDescriptorSet(mPipeline->pipelineLayout(),
+                                       0,
+                                       mDescriptorSets[0].get());
+                _cmd.bindVertexBuffer(0, mVertexBuffers[mCurrFrame]->get());
+                _cmd.bindIndexBuffer(mIndexBuffers[mCurrFrame]->get(), 0,
+                                     VulkanUtils::GetIndexType(_renderData.indexFormat));
+
+                _cmd.pushConstants(mPipeline->pipelineLayout(), vk::ShaderStageFlagBits::eVertex, 0,
+                                   sizeof(Vector2f), _renderData.scale.linear);
+                _cmd.pushConstants(mPipeline->pipelineLayout(), vk::ShaderStageFlagBits::eVertex,
+                                   sizeof(Vector2f), sizeof(Vector2f), _renderData.translate.linear);
 
                 auto drawData = _renderData.drawData;
 
@@ -98,7 +95,7 @@ namespace Mix {
                 viewport.height = static_cast<float>(fbHeight);
                 viewport.minDepth = 0.0f;
                 viewport.maxDepth = 1.0f;
-                cmd.get().setViewport(0, viewport);
+                _cmd.setViewport(viewport);
 
                 Vector2f clipOff{ drawData->DisplayPos.x, drawData->DisplayPos.y };
                 // (0,0) unless using multi-viewports
@@ -133,10 +130,11 @@ namespace Mix {
                             scissor.offset.y = static_cast<int32_t>(clipRect.y);
                             scissor.extent.width = static_cast<uint32_t>(clipRect.z - clipRect.x);
                             scissor.extent.height = static_cast<uint32_t>(clipRect.w - clipRect.y);
-                            cmd.get().setScissor(0, 1, &scissor);
+                            // Consecutive draws often share their clip rectangle
+                            _cmd.setScissor(scissor);
                             // Draw
-                            cmd.get().drawIndexed(pcmd->ElemCount, 1, pcmd->IdxOffset + idxOffset,
-                                                  pcmd->VtxOffset + vtxOffset, 0);
+                            _cmd.drawIndexed(pcmd->ElemCount, 1, pcmd->IdxOffset + idxOffset,
+                                             pcmd->VtxOffset + vtxOffset, 0);
                         }
                     }
                     idxOffset += cmdList->IdxBuffer.Size;
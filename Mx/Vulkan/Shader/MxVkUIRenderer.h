@@ -26,7 +26,8 @@ namespace Mix {
         public:
             explicit UIRenderer(VulkanAPI* _vulkan);
 
-            void render(GUI::UIRenderData& _renderData);
+            /** \brief Record the UI into _cmd, a command buffer inside the render pass. */
+            void render(CommandStateCache& _cmd, GUI::UIRenderData& _renderData);
 
         private:
             void build();
@@ -12,6 +12,11 @@ layout(push_constant) uniform MeshConstant {
 	mat4 modelMat;
 }mesh;
 
+// Instance 0 is never written, draws of a single element use the push constant
+layout(set = 0, binding = 1) readonly buffer InstanceBuffer {
+	mat4 modelMats[];
+}instances;
+
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inTexCoord;
@@ -31,7 +36,8 @@ mat3 getNormalMatFromModelMat(mat4 modelMat){
 
 void main() 
 {
-    gl_Position = camera.projMat * camera.viewMat * mesh.modelMat * vec4(inPosition, 1.0f);
-	outNormal= getNormalMatFromModelMat(mesh.modelMat) * inNormal;
+    mat4 modelMat = gl_InstanceIndex == 0 ? mesh.modelMat : instances.modelMats[gl_InstanceIndex];
+    gl_Position = camera.projMat * camera.viewMat * modelMat * vec4(inPosition, 1.0f);
+	outNormal= getNormalMatFromModelMat(modelMat) * inNormal;
 	outUV=vec2(inTexCoord);
 }
\ No newline at end of file
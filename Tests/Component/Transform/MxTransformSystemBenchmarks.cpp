@@ -0,0 +1,63 @@
+#include "../../MxTest.h"
+#include "../../../Mx/Component/Transform/MxTransformSystem.h"
+
+namespace Mix {
+    /** \brief Build a tree of _count nodes where every node has up to _fanOut children, return its nodes in creation order. */
+    static std::vector<TransformSystem::NodeId> BuildTree(TransformSystem& _system, uint32_t _count, uint32_t _fanOut) {
+        std::vector<TransformSystem::NodeId> nodes;
+        nodes.reserve(_count);
+        for (uint32_t i = 0; i < _count; ++i) {
+            nodes.push_back(_system.createNode());
+            if (i != 0)
+                _system.setParent(nodes[i], nodes[(i - 1) / _fanOut]);
+        }
+        return nodes;
+    }
+
+    MX_BENCHMARK(TransformSystem_MoveRootOf10kTree) {
+        Test::UseThreadPool();
+
+        for (uint32_t fanOut : { 1u, 4u }) {
+            TransformSystem system;
+            const auto root = BuildTree(system, 10000, fanOut).front();
+            system.update();
+
+            float x = 0.0f;
+            const std::string label = fanOut == 1 ? "chain" : "fan out 4";
+            Test::Measure((label + ": setLocalPosition(root)").c_str(), 100000, [&] {
+                system.setLocalPosition(root, Vector3f(x += 1.0f, 0.0f, 0.0f));
+            });
+            Test::Measure((label + ": setLocalPosition(root) + update()").c_str(), 200, [&] {
+                system.setLocalPosition(root, Vector3f(x += 1.0f, 0.0f, 0.0f));
+                system.update();
+            });
+            Test::Measure((label + ": update() with nothing changed").c_str(), 200, [&] {
+                system.update();
+            });
+        }
+    }
+
+    MX_BENCHMARK(TransformSystem_EditLeavesOf10kTree) {
+        Test::UseThreadPool();
+
+        // Leaf edits patch the levels they touch instead of re-sorting all nodes in the next update()
+        TransformSystem system;
+        const auto nodes = BuildTree(system, 10000, 4);
+        system.update();
+
+        const auto leaf = nodes.back();
+        const TransformSystem::NodeId parents[] = { nodes[1], nodes[(nodes.size() - 2) / 4] };
+        uint32_t flip = 0;
+        Test::Measure("setParent(leaf) across levels + update()", 200, [&] {
+            system.setParent(leaf, parents[flip ^= 1]);
+            system.update();
+        });
+
+        Test::Measure("create, attach and destroy a leaf + update()", 200, [&] {
+            const auto node = system.createNode();
+            system.setParent(node, parents[0]);
+            system.destroyNode(node);
+            system.update();
+        });
+    }
+}
@@ -0,0 +1,132 @@
+#include "../../MxTest.h"
+#include "../../../Mx/Component/Transform/MxTransformSystem.h"
+#include <algorithm>
+#include <random>
+
+namespace Mix {
+    MX_TEST(TransformSystem_DestroyLastRootAfterUpdate) {
+        Test::UseThreadPool();
+        TransformSystem system;
+
+        // The level offsets built by the first update() must shrink with the dense arrays
+        const auto root = system.createNode();
+        system.update();
+        system.destroyNode(root);
+        system.update();
+        MX_CHECK(system.nodeCount() == 0);
+
+        const auto a = system.createNode();
+        const auto b = system.createNode();
+        system.update();
+        system.destroyNode(b);
+        system.setLocalPosition(a, Vector3f(1.0f, 2.0f, 3.0f));
+        system.update();
+        MX_CHECK(system.nodeCount() == 1);
+        MX_CHECK(system.wasUpdated(a));
+        MX_CHECK(system.getCachedLocalToWorld(a).getTranslation() == Vector3f(1.0f, 2.0f, 3.0f));
+    }
+
+    MX_TEST(TransformSystem_ChildFollowsParent) {
+        Test::UseThreadPool();
+        TransformSystem system;
+
+        const auto parent = system.createNode();
+        const auto child = system.createNode();
+        system.setParent(child, parent);
+        system.setLocalPosition(child, Vector3f(0.0f, 1.0f, 0.0f));
+        system.update();
+
+        system.setLocalPosition(parent, Vector3f(5.0f, 0.0f, 0.0f));
+        MX_CHECK(system.isDirty(child));
+        system.update();
+        MX_CHECK(!system.isDirty(child));
+        MX_CHECK(system.wasUpdated(child));
+        MX_CHECK(system.getCachedLocalToWorld(child).getTranslation() == Vector3f(5.0f, 1.0f, 0.0f));
+
+        auto updated = system.getUpdatedNodes();
+        std::sort(updated.begin(), updated.end());
+        MX_CHECK((updated == std::vector<TransformSystem::NodeId>{ parent, child }));
+
+        system.update();
+        MX_CHECK(system.getUpdatedNodes().empty());
+    }
+
+    MX_TEST(TransformSystem_CreateRootsBetweenUpdates) {
+        Test::UseThreadPool();
+        TransformSystem system;
+
+        // New roots go to level 0 while a deeper level exists
+        const auto parent = system.createNode();
+        const auto child = system.createNode();
+        system.setParent(child, parent);
+        system.update();
+
+        std::vector<TransformSystem::NodeId> roots;
+        for (uint32_t i = 0; i < 4; ++i) {
+            roots.push_back(system.createNode());
+            system.setLocalPosition(roots.back(), Vector3f(float(i), 0.0f, 0.0f));
+        }
+        system.setLocalPosition(parent, Vector3f(0.0f, 2.0f, 0.0f));
+        system.update();
+
+        MX_CHECK(system.getCachedLocalToWorld(child).getTranslation() == Vector3f(0.0f, 2.0f, 0.0f));
+        for (uint32_t i = 0; i < 4; ++i)
+            MX_CHECK(system.getCachedLocalToWorld(roots[i]).getTranslation() == Vector3f(float(i), 0.0f, 0.0f));
+
+        system.destroyNode(roots.back());
+        system.setParent(roots.front(), child);
+        system.update();
+        MX_CHECK(system.nodeCount() == 5);
+        MX_CHECK(system.getCachedLocalToWorld(roots.front()).getTranslation() == Vector3f(0.0f, 2.0f, 0.0f));
+    }
+
+    MX_TEST(TransformSystem_HierarchyEditsKeepLevelsValid) {
+        Test::UseThreadPool();
+        TransformSystem system;
+
+        // Only translations, so a world position is the sum of the local positions on the ancestor chain
+        std::vector<TransformSystem::NodeId> alive;
+        std::mt19937 random(7);
+        auto pick = [&] { return alive[random() % alive.size()]; };
+        auto isAncestor = [&](TransformSystem::NodeId _ancestor, TransformSystem::NodeId _node) {
+            for (auto node = _node; node != TransformSystem::InvalidNode; node = system.getParent(node)) {
+                if (node == _ancestor)
+                    return true;
+            }
+            return false;
+        };
+
+        for (uint32_t round = 0; round < 50; ++round) {
+            for (uint32_t op = 0; op < 40; ++op) {
+                const uint32_t kind = alive.size() < 8 ? 0 : random() % 4;
+                if (kind == 0) {
+                    alive.push_back(system.createNode());
+                    system.setLocalPosition(alive.back(), Vector3f(float(random() % 8), float(random() % 8), 0.0f));
+                }
+                else if (kind == 1) {
+                    const auto node = pick();
+                    const auto parent = pick();
+                    system.setParent(node, isAncestor(node, parent) ? TransformSystem::InvalidNode : parent);
+                }
+                else if (kind == 2) {
+                    const auto node = pick();
+                    system.destroyNode(node);
+                    alive.erase(std::find(alive.begin(), alive.end(), node));
+                }
+                else {
+                    system.setLocalPosition(pick(), Vector3f(float(random() % 8), float(random() % 8), 0.0f));
+                }
+            }
+
+            system.update();
+            MX_CHECK(system.nodeCount() == alive.size());
+            for (const auto node : alive) {
+                Vector3f expected = Vector3f::Zero;
+                for (auto curr = node; curr != TransformSystem::InvalidNode; curr = system.getParent(curr))
+                    expected += system.getLocalPosition(curr);
+                MX_CHECK(!system.isDirty(node));
+                MX_CHECK(system.getCachedLocalToWorld(node).getTranslation() == expected);
+            }
+        }
+    }
+}
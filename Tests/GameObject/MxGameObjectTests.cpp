@@ -0,0 +1,44 @@
+#include "../MxTest.h"
+#include "../../Mx/GameObject/MxGameObject.h"
+
+namespace Mix {
+    MX_TEST(GameObject_FindChildrenKeepsChildOrder) {
+        Test::UseGraphics();
+
+        // FindRoot
+        //   a
+        //     Hit     hitA0
+        //   Hit       hit1
+        //     Hit     hit1a
+        //   Hit       hit2
+        auto root = GameObject::Instantiate("FindRoot");
+        auto a = GameObject::Instantiate(root, "a");
+        auto hitA0 = GameObject::Instantiate(a, "Hit");
+        auto hit1 = GameObject::Instantiate(root, "Hit");
+        auto hit1a = GameObject::Instantiate(hit1, "Hit");
+        auto hit2 = GameObject::Instantiate(root, "Hit");
+
+        // Namesakes outside the hierarchy make the name bucket larger than the subtree, so it is walked
+        auto others = GameObject::Instantiate("Others");
+        for (uint32_t i = 0; i < 8; ++i)
+            GameObject::Instantiate(others, "Hit");
+
+        for (const bool filterBucket : { false, true }) {
+            // A larger subtree makes the search filter the name bucket instead
+            if (filterBucket) {
+                for (uint32_t i = 0; i < 64; ++i)
+                    GameObject::Instantiate(a, "Filler");
+            }
+
+            MX_CHECK(root->findChildren("Hit") == std::vector<HGameObject>({ hitA0, hit1, hit1a, hit2 }));
+            MX_CHECK(root->findChild("Hit") == hitA0);
+            MX_CHECK(root->findChildren("Hit", false) == std::vector<HGameObject>({ hit1, hit2 }));
+            MX_CHECK(root->findChild("Hit", false) == hit1);
+            MX_CHECK(a->findChildren("Hit") == std::vector<HGameObject>({ hitA0 }));
+            MX_CHECK(!root->findChild("Missing"));
+        }
+
+        others->destroy(true);
+        root->destroy(true);
+    }
+}
@@ -0,0 +1,213 @@
+#include "../MxTest.h"
+#include "../../Mx/Graphics/MxDrawChunks.h"
+#include "../../Mx/Graphics/MxGraphics.h"
+#include "../../Mx/Graphics/MxMaterial.h"
+#include "../../Mx/Graphics/Mesh/MxMesh.h"
+#include "../../Mx/GameObject/MxGameObject.h"
+#include "../../Mx/Thread/MxThreadPool.h"
+#include <deque>
+#include <string>
+
+namespace Mix {
+    namespace {
+        /** \brief Stands in for a Vulkan::DrawContext, records what the shaders were asked to do. */
+        struct MockContext {
+            std::vector<uint32_t> begun;
+            uint32_t ended = 0;
+            std::vector<std::string> draws;
+        };
+
+        struct MockShader {
+            uint32_t id;
+
+            void beginRender(MockContext& _context) { _context.begun.push_back(id); }
+
+            void endRender(MockContext& _context) { ++_context.ended; }
+
+            void render(MockContext& _context, RenderElement& _element) {
+                _context.draws.push_back(std::to_string(id) + " single " + Name(&_element));
+            }
+
+            void renderInstanced(MockContext& _context, RenderElement* const* _elements, uint32_t _count) {
+                _context.draws.push_back(std::to_string(id) + " instanced " + Name(_elements[0]) + " x" + std::to_string(_count));
+            }
+
+            static std::string Name(const RenderElement* _element) {
+                return std::to_string(reinterpret_cast<uintptr_t>(_element));
+            }
+        };
+
+        struct Run {
+            uint32_t shaderId;
+            uint32_t length;
+        };
+
+        /** \brief Sorted queues of elements sharing one Transform, a deque keeps the element addresses stable. */
+        struct MockScene {
+            HGameObject object;
+            std::shared_ptr<Mesh> meshes[2];
+            std::shared_ptr<Material> material;
+            std::deque<RenderElement> elements;
+            MockShader shaders[3] = { { 0 }, { 1 }, { 2 } };
+
+            MockScene() {
+                Test::UseGraphics();
+                object = GameObject::Instantiate("DrawChunks");
+                meshes[0] = std::make_shared<Mesh>();
+                meshes[1] = std::make_shared<Mesh>();
+                material = std::make_shared<Material>(Graphics::Get()->findShader("Standard"));
+            }
+
+            ~MockScene() { object->destroy(true); }
+
+            /** \brief Append the runs to _queue, consecutive runs use different meshes so they are never instanced together. */
+            void append(std::vector<RenderQueueElement>& _queue, const std::vector<Run>& _runs) {
+                for (size_t r = 0; r < _runs.size(); ++r) {
+                    for (uint32_t i = 0; i < _runs[r].length; ++i) {
+                        RenderElement& element = elements.emplace_back();
+                        element.transform = object->transformHandle();
+                        element.mesh = meshes[r % 2];
+                        element.material = material;
+                        element.submesh = 0;
+                        _queue.push_back(RenderQueueElement{ &element, _runs[r].shaderId });
+                    }
+                }
+            }
+
+            MockShader& getShader(uint32_t _id) { return shaders[_id]; }
+        };
+
+        std::vector<Run> Singles(uint32_t _shaderId, uint32_t _count) {
+            return std::vector<Run>(_count, Run{ _shaderId, 1 });
+        }
+
+        /** \brief Check that the chunks of one queue cover it in order without splitting an instanced run. */
+        void CheckChunks(const std::vector<RenderQueueElement>& _queue, const DrawChunk* _chunks, size_t _chunkCount) {
+            uint32_t covered = 0;
+            for (size_t c = 0; c < _chunkCount; ++c) {
+                const DrawChunk& chunk = _chunks[c];
+                MX_CHECK(chunk.first == covered);
+                MX_CHECK(chunk.count > 0);
+                if (c + 1 < _chunkCount)
+                    MX_CHECK(chunk.count >= MinDrawChunkSize);
+                if (chunk.first > 0)
+                    MX_CHECK(!IsSameInstance(*_queue[chunk.first - 1].element, *_queue[chunk.first].element));
+                covered += chunk.count;
+            }
+            MX_CHECK(covered == _queue.size());
+        }
+    }
+
+    MX_TEST(DrawChunks_EmptyQueues) {
+        std::vector<RenderQueueElement> empty;
+        std::vector<DrawChunk> chunks = { DrawChunk{ 0, 1 } };
+        MX_CHECK(SplitDrawQueues(empty, empty, 9, chunks) == 0);
+        MX_CHECK(chunks.empty());
+
+        MockShader shader{ 0 };
+        MockContext context;
+        std::vector<RenderElement*> run;
+        RecordDrawChunk(empty.data(), 0, context, [&](uint32_t) -> MockShader& { return shader; }, run);
+        MX_CHECK(context.begun.empty() && context.ended == 0 && context.draws.empty());
+    }
+
+    MX_TEST(DrawChunks_MaxChunksAndMinSize) {
+        MockScene scene;
+        const uint32_t slotCount = 9;
+        const uint32_t maxChunks = (slotCount - 1) / 2;
+
+        // Fewer elements than MinDrawChunkSize stay in one chunk
+        std::vector<RenderQueueElement> few;
+        scene.append(few, Singles(0, MinDrawChunkSize - 1));
+        std::vector<DrawChunk> chunks;
+        MX_CHECK(SplitDrawQueues(few, {}, slotCount, chunks) == 1);
+        MX_CHECK(chunks.size() == 1 && chunks[0].count == few.size());
+
+        // MinDrawChunkSize bounds the chunk count before maxChunks does
+        std::vector<RenderQueueElement> some;
+        scene.append(some, Singles(0, MinDrawChunkSize * 2 + 1));
+        SplitDrawQueues(some, {}, slotCount, chunks);
+        MX_CHECK(chunks.size() == 3);
+        CheckChunks(some, chunks.data(), chunks.size());
+
+        // Many elements are spread over maxChunks chunks per queue
+        std::vector<RenderQueueElement> opaque, transparent;
+        scene.append(opaque, Singles(0, MinDrawChunkSize * maxChunks * 4));
+        scene.append(transparent, Singles(2, MinDrawChunkSize * maxChunks * 2 + 3));
+        const uint32_t opaqueChunkCount = SplitDrawQueues(opaque, transparent, slotCount, chunks);
+        MX_CHECK(opaqueChunkCount == maxChunks);
+        MX_CHECK(chunks.size() == maxChunks * 2);
+        MX_CHECK(chunks.size() <= slotCount - 1);
+        CheckChunks(opaque, chunks.data(), opaqueChunkCount);
+        CheckChunks(transparent, chunks.data() + opaqueChunkCount, chunks.size() - opaqueChunkCount);
+    }
+
+    MX_TEST(DrawChunks_InstancedRunsStayWhole) {
+        MockScene scene;
+        std::vector<RenderQueueElement> queue;
+        scene.append(queue, { Run{ 0, MinDrawChunkSize * 8 } });
+
+        std::vector<DrawChunk> chunks;
+        SplitDrawQueues(queue, {}, 9, chunks);
+        MX_CHECK(chunks.size() == 1);
+
+        MockContext context;
+        std::vector<RenderElement*> run;
+        RecordDrawChunk(queue.data(), static_cast<uint32_t>(queue.size()), context,
+                        [&](uint32_t _id) -> MockShader& { return scene.getShader(_id); }, run);
+        MX_CHECK(context.draws.size() == 1);
+        MX_CHECK(context.draws[0] == "0 instanced " + MockShader::Name(queue[0].element) + " x" + std::to_string(queue.size()));
+    }
+
+    MX_TEST(DrawChunks_ExecutedSlotsKeepSortedOrder) {
+        MockScene scene;
+
+        // Shader switches and instanced runs of several lengths, some straddling the even split points
+        std::vector<Run> opaqueRuns, transparentRuns;
+        for (uint32_t i = 0; i < 600; ++i)
+            opaqueRuns.push_back(Run{ i < 400 ? 0u : 1u, i % 13 == 0 ? 37u : 1u });
+        for (uint32_t i = 0; i < 300; ++i)
+            transparentRuns.push_back(Run{ 2, i % 29 == 0 ? 90u : 1u });
+
+        std::vector<RenderQueueElement> opaque, transparent;
+        scene.append(opaque, opaqueRuns);
+        scene.append(transparent, transparentRuns);
+        auto getShader = [&](uint32_t _id) -> MockShader& { return scene.getShader(_id); };
+
+        // What a single command buffer would draw
+        MockContext serial;
+        std::vector<RenderElement*> run;
+        RecordDrawChunk(opaque.data(), static_cast<uint32_t>(opaque.size()), serial, getShader, run);
+        RecordDrawChunk(transparent.data(), static_cast<uint32_t>(transparent.size()), serial, getShader, run);
+
+        // Recorded the way Graphics::recordQueues() does, one slot per chunk
+        const uint32_t slotCount = 9;
+        std::vector<DrawChunk> chunks;
+        const uint32_t opaqueChunkCount = SplitDrawQueues(opaque, transparent, slotCount, chunks);
+        const uint32_t chunkCount = static_cast<uint32_t>(chunks.size());
+        MX_CHECK(opaqueChunkCount > 1 && chunkCount - opaqueChunkCount > 1);
+        MX_CHECK(chunkCount <= slotCount - 1);
+        CheckChunks(opaque, chunks.data(), opaqueChunkCount);
+        CheckChunks(transparent, chunks.data() + opaqueChunkCount, chunkCount - opaqueChunkCount);
+
+        std::vector<MockContext> slots(slotCount);
+        std::vector<std::vector<RenderElement*>> runs(slotCount);
+        ThreadPool::Get()->parallelFor(0, chunkCount, 1, [&](uint32_t _begin, uint32_t _end) {
+            for (uint32_t c = _begin; c < _end; ++c) {
+                const RenderQueueElement* elements = c < opaqueChunkCount ? opaque.data() : transparent.data();
+                RecordDrawChunk(elements + chunks[c].first, chunks[c].count, slots[c], getShader, runs[c]);
+            }
+        });
+
+        // Executing the slots in chunk order must replay the serial draws
+        std::vector<std::string> executed;
+        for (uint32_t c = 0; c < chunkCount; ++c) {
+            const MockContext& slot = slots[c];
+            const RenderQueueElement* elements = c < opaqueChunkCount ? opaque.data() : transparent.data();
+            MX_CHECK(!slot.begun.empty() && slot.begun.size() == slot.ended);
+            MX_CHECK(slot.begun.front() == elements[chunks[c].first].shaderId);
+            executed.insert(executed.end(), slot.draws.begin(), slot.draws.end());
+        }
+        MX_CHECK(executed == serial.draws);
+    }
+}
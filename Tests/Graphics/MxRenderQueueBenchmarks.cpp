@@ -0,0 +1,120 @@
+#include "../MxTest.h"
+#include "../../Mx/Graphics/MxRenderQueue.h"
+#include "../../Mx/Graphics/MxGraphics.h"
+#include "../../Mx/Graphics/MxMaterial.h"
+#include "../../Mx/Graphics/MxShader.h"
+#include "../../Mx/Graphics/Mesh/MxMesh.h"
+#include <algorithm>
+#include <random>
+
+namespace Mix {
+    namespace {
+        /** \brief The queue replaced by the radix sort: an index array sorted by (shader, distance), then copied. */
+        class LegacyRenderQueue {
+        public:
+            void push(RenderElement* _element, float _distFromCamera) {
+                mSortIndex.push_back(mSortElements.size());
+                mSortElements.push_back(SortElement{ _element, _distFromCamera, _element->material->getShader()->getId() });
+            }
+
+            void clear() {
+                mSortElements.clear();
+                mSortIndex.clear();
+                mSortedElements.clear();
+            }
+
+            void sort() {
+                std::sort(mSortIndex.begin(), mSortIndex.end(), [&](const size_t& _a, const size_t& _b) {
+                    auto& eleA = mSortElements[_a];
+                    auto& eleB = mSortElements[_b];
+                    uint8_t h = (eleA.shaderId > eleB.shaderId) << 1 | (eleA.disFromCamera > eleB.disFromCamera);
+                    uint8_t l = (eleA.shaderId < eleB.shaderId) << 1 | (eleA.disFromCamera < eleB.disFromCamera);
+                    return l > h;
+                });
+
+                for (auto& idx : mSortIndex)
+                    mSortedElements.push_back(RenderQueueElement{ mSortElements[idx].element, mSortElements[idx].shaderId });
+            }
+
+            const std::vector<RenderQueueElement>& getSortedElements() const { return mSortedElements; }
+
+        private:
+            struct SortElement {
+                RenderElement* element;
+                float disFromCamera;
+                uint32_t shaderId;
+            };
+
+            std::vector<SortElement> mSortElements;
+            std::vector<size_t> mSortIndex;
+            std::vector<RenderQueueElement> mSortedElements;
+        };
+
+        constexpr uint32_t ElementCount = 100000;
+        constexpr uint32_t MaterialCount = 256;
+        constexpr uint32_t LayoutCount = 8;
+
+        /** \brief A quad whose vertex layout is picked by the bits of _layout, so every layout is its own pipeline. */
+        std::shared_ptr<Mesh> MakeQuad(uint32_t _layout) {
+            auto mesh = std::make_shared<Mesh>();
+            mesh->setPositions({ Vector3f(0.0f, 0.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f), Vector3f(1.0f, 1.0f, 0.0f), Vector3f(0.0f, 1.0f, 0.0f) });
+            if (_layout & 1)
+                mesh->setNormals(std::vector<Mesh::NormalType>(4, Vector3f(0.0f, 0.0f, 1.0f)));
+            if (_layout & 2)
+                mesh->setUVs(UVChannel::UV0, std::vector<Mesh::UV2DType>(4));
+            if (_layout & 4)
+                mesh->setColors(std::vector<Mesh::ColorType>(4));
+            mesh->setIndices({ 0, 1, 2, 0, 2, 3 }, MeshTopology::Triangles_List, 0);
+            mesh->uploadMeshData(false);
+            return mesh;
+        }
+    }
+
+    MX_BENCHMARK(RenderQueue_Sort100k) {
+        Test::UseGraphics();
+
+        const std::shared_ptr<Shader> shaders[] = { Graphics::Get()->findShader("Standard"), Graphics::Get()->findShader("PBR") };
+        std::vector<std::shared_ptr<Material>> materials;
+        for (uint32_t i = 0; i < MaterialCount; ++i)
+            materials.push_back(std::make_shared<Material>(shaders[i % 2]));
+        std::vector<std::shared_ptr<Mesh>> meshes;
+        for (uint32_t i = 0; i < LayoutCount; ++i)
+            meshes.push_back(MakeQuad(i));
+
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> distances(0.1f, 1000.0f);
+        std::vector<RenderElement> elements(ElementCount);
+        std::vector<float> elementDistances(ElementCount);
+        for (uint32_t i = 0; i < ElementCount; ++i) {
+            elements[i].mesh = meshes[random() % LayoutCount];
+            elements[i].material = materials[random() % MaterialCount];
+            elements[i].submesh = 0;
+            elementDistances[i] = distances(random);
+        }
+
+        // Both measures push the whole frame again, sorting moves the elements
+        RenderQueue queue;
+        Test::Measure("RenderQueue: push + radix sort 100k", 50, [&] {
+            queue.clear();
+            for (uint32_t i = 0; i < ElementCount; ++i)
+                queue.push(&elements[i], elementDistances[i]);
+            queue.sort();
+        });
+
+        LegacyRenderQueue legacyQueue;
+        Test::Measure("legacy: push + index std::sort 100k", 50, [&] {
+            legacyQueue.clear();
+            for (uint32_t i = 0; i < ElementCount; ++i)
+                legacyQueue.push(&elements[i], elementDistances[i]);
+            legacyQueue.sort();
+        });
+
+        // Both orders group by shader first
+        auto& sorted = queue.getSortedElements();
+        MX_CHECK(sorted.size() == ElementCount);
+        MX_CHECK(std::is_sorted(sorted.begin(), sorted.end(), [](const RenderQueueElement& _a, const RenderQueueElement& _b) {
+            return _a.shaderId < _b.shaderId;
+        }));
+        MX_CHECK(legacyQueue.getSortedElements().size() == ElementCount);
+    }
+}
@@ -0,0 +1,37 @@
+#include "../MxTest.h"
+#include "../../Mx/Graphics/MxStaticBatch.h"
+#include "../../Mx/Graphics/MxGraphics.h"
+#include "../../Mx/Graphics/MxMaterial.h"
+#include "../../Mx/Graphics/Mesh/MxMesh.h"
+#include "../../Mx/GameObject/MxGameObject.h"
+#include "../../Mx/Component/Renderer/MxRenderer.h"
+#include "../../Mx/Component/MeshFilter/MxMeshFilter.h"
+
+namespace Mix {
+    MX_TEST(StaticBatch_BuildFromIndexedReadableMesh) {
+        Test::UseGraphics();
+
+        auto mesh = std::make_shared<Mesh>();
+        mesh->setPositions({ Vector3f(0.0f, 0.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f), Vector3f(1.0f, 1.0f, 0.0f), Vector3f(0.0f, 1.0f, 0.0f) });
+        mesh->setIndices({ 0, 1, 2, 0, 2, 3 }, MeshTopology::Triangles_List, 0);
+        mesh->uploadMeshData(false);
+        MX_CHECK(mesh->isReadable());
+        MX_CHECK(mesh->hasIndices());
+
+        auto object = GameObject::Instantiate("Quad", "", 0, GameObjectFlags::IsStatic);
+        object->addComponent<MeshFilter>()->setMesh(mesh);
+        auto renderer = object->addComponent<Renderer>();
+        renderer->setMaterial(std::make_shared<Material>(Graphics::Get()->findShader("Standard")));
+
+        Renderer* renderers[] = { &*renderer };
+        auto batches = StaticBatch::Build(renderers, 1);
+        MX_CHECK(batches.size() == 1);
+        MX_CHECK(batches.front().getPieces().size() == 1);
+        MX_CHECK(batches.front().getMesh() && batches.front().getMesh()->hasIndices());
+        MX_CHECK(renderer->isStaticBatched());
+
+        for (auto& batch : batches)
+            batch.release();
+        object->destroy(true);
+    }
+}
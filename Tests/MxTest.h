@@ -0,0 +1,93 @@
+#pragma once
+#ifndef MX_TEST_H_
+#define MX_TEST_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Mix {
+    namespace Test {
+        using TestFunc = void(*)();
+
+        struct TestCase {
+            const char* name;
+            TestFunc func;
+            bool benchmark;
+        };
+
+        std::vector<TestCase>& Registry();
+
+        struct Registrar {
+            Registrar(const char* _name, TestFunc _func, bool _benchmark) {
+                Registry().push_back(TestCase{ _name, _func, _benchmark });
+            }
+        };
+
+        /** \brief Thrown by MX_CHECK, caught by the runner which reports it and moves on to the next test. */
+        struct Failure {
+            std::string message;
+        };
+
+        [[noreturn]] void Fail(const char* _expr, const char* _file, int _line);
+
+        /** \brief Add a ThreadPool with _threadCount workers to the engine, only the first call has an effect. */
+        void UseThreadPool(uint32_t _threadCount = 3);
+
+        /**
+         * \brief Load the modules needed to create GameObjects and upload Meshes, with a hidden window, and
+         *        activate an empty Scene. Only the first call has an effect.
+         * \note  Needs a Vulkan capable device.
+         */
+        void UseGraphics();
+
+        /**
+         * \brief Run _func _iterations times and print the average time of one call.
+         * \return The average time in nanoseconds.
+         */
+        template<typename _Func>
+        double Measure(const char* _label, uint32_t _iterations, _Func&& _func);
+
+        void Report(const char* _label, double _nanoseconds);
+    }
+}
+
+/** \brief Define a test case, registered at static initialization. */
+#define MX_TEST(_name)                                                                  \
+    static void _name();                                                                \
+    static const Mix::Test::Registrar _name##Registrar(#_name, &_name, false);          \
+    static void _name()
+
+/** \brief Define a benchmark, only run when the runner is given --benchmark. */
+#define MX_BENCHMARK(_name)                                                             \
+    static void _name();                                                                \
+    static const Mix::Test::Registrar _name##Registrar(#_name, &_name, true);           \
+    static void _name()
+
+#define MX_CHECK(_expr)                                                                 \
+    do {                                                                                \
+        if (!(_expr))                                                                   \
+            Mix::Test::Fail(#_expr, __FILE__, __LINE__);                                \
+    } while (false)
+
+namespace Mix {
+    namespace Test {
+        template<typename _Func>
+        double Measure(const char* _label, uint32_t _iterations, _Func&& _func) {
+            // One untimed call to warm up caches and lazily allocated buffers
+            _func();
+
+            const auto begin = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < _iterations; ++i)
+                _func();
+            const auto end = std::chrono::steady_clock::now();
+
+            const double nanoseconds = std::chrono::duration<double, std::nano>(end - begin).count() / _iterations;
+            Report(_label, nanoseconds);
+            return nanoseconds;
+        }
+    }
+}
+
+#endif
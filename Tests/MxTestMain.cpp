@@ -0,0 +1,107 @@
+#include "MxTest.h"
+#include "../MixEngine.h"
+#include "../Mx/Thread/MxThreadPool.h"
+#include "../Mx/Engine/MxPlatform.h"
+#include "../Mx/Window/MxWindow.h"
+#include "../Mx/Graphics/MxGraphics.h"
+#include "../Mx/Resource/MxResourceLoader.h"
+#include "../Mx/Component/Transform/MxTransformSystem.h"
+#include "../Mx/Scene/MxSceneObjectManager.h"
+#include "../Mx/Scene/MxSceneManager.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace Mix {
+    namespace Test {
+        std::vector<TestCase>& Registry() {
+            static std::vector<TestCase> registry;
+            return registry;
+        }
+
+        void Fail(const char* _expr, const char* _file, int _line) {
+            throw Failure{ std::string(_file) + ":" + std::to_string(_line) + ": check failed: " + _expr };
+        }
+
+        void UseThreadPool(uint32_t _threadCount) {
+            auto& engine = MixEngine::Instance();
+            if (!engine.hasModule<ThreadPool>())
+                engine.addModule<ThreadPool>(_threadCount)->load();
+        }
+
+        void UseGraphics() {
+            auto& engine = MixEngine::Instance();
+            if (engine.hasModule<Graphics>())
+                return;
+
+            // Same order as MixEngine::loadModule(), without the modules a test has no use for
+            Platform::Initialize();
+            UseThreadPool();
+            engine.addModule<Window>("MxTests", Vector2i{ 64, 64 }, WindowFlag::Vulkan | WindowFlag::Hidden)->load();
+            engine.addModule<Graphics>()->load();
+            engine.addModule<ResourceLoader>()->load();
+            engine.addModule<TransformSystem>()->load();
+            engine.addModule<SceneObjectManager>()->load();
+            engine.addModule<SceneManager>()->load();
+            for (auto module : engine.getModuleHolder().getAllOrdered())
+                module->init();
+
+            auto sceneManager = SceneManager::Get();
+            auto scene = sceneManager->createScene("TestScene");
+            sceneManager->loadScene(scene->getIndex());
+            sceneManager->setActiveScene(scene);
+        }
+
+        void Report(const char* _label, double _nanoseconds) {
+            std::printf("    %-48s %12.1f ns\n", _label, _nanoseconds);
+        }
+    }
+}
+
+/**
+ * Runs the tests, or the benchmarks with --benchmark, whose name contains one of the other arguments.
+ * There is no build target for Tests/ yet: compile its sources together with the engine sources into
+ * an executable of your own. This file has to be left out of any build that has its own main().
+ */
+int main(int _argc, char** _argv) {
+    using namespace Mix;
+
+    bool benchmark = false;
+    std::vector<const char*> filters;
+    for (int i = 1; i < _argc; ++i) {
+        if (std::strcmp(_argv[i], "--benchmark") == 0)
+            benchmark = true;
+        else
+            filters.push_back(_argv[i]);
+    }
+
+    MixEngine::Initialize("MixEngine");
+
+    uint32_t run = 0;
+    uint32_t failed = 0;
+    for (auto& test : Test::Registry()) {
+        if (test.benchmark != benchmark)
+            continue;
+        if (!filters.empty() && std::none_of(filters.begin(), filters.end(),
+                                             [&test](const char* _filter) { return std::strstr(test.name, _filter); }))
+            continue;
+
+        ++run;
+        std::printf("[ RUN  ] %s\n", test.name);
+        try {
+            test.func();
+            std::printf("[  OK  ] %s\n", test.name);
+        }
+        catch (const Test::Failure& _failure) {
+            ++failed;
+            std::printf("%s\n[ FAIL ] %s\n", _failure.message.c_str(), test.name);
+        }
+        catch (const std::exception& _e) {
+            ++failed;
+            std::printf("unexpected exception: %s\n[ FAIL ] %s\n", _e.what(), test.name);
+        }
+    }
+
+    std::printf("%u run, %u failed\n", run, failed);
+    return failed == 0 ? 0 : 1;
+}
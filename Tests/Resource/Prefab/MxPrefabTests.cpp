@@ -0,0 +1,69 @@
+#include "../../MxTest.h"
+#include "../../../Mx/Resource/Prefab/MxPrefab.h"
+#include "../../../Mx/Graphics/MxGraphics.h"
+#include "../../../Mx/Graphics/MxMaterial.h"
+#include "../../../Mx/Component/Camera/MxCamera.h"
+#include "../../../Mx/Component/Renderer/MxRenderer.h"
+#include "../../../Mx/Scene/MxScene.h"
+#include "../../../Mx/Scene/MxSceneManager.h"
+
+namespace Mix {
+    /** \brief Stands in for game logic such as an enemy AI, which no ComponentSerializers entry knows. */
+    class PrefabTestWalker :public Behaviour {
+        MX_DECLARE_RTTI;
+    public:
+        explicit PrefabTestWalker(float _speed = 1.0f) :speed(_speed) {}
+
+        float speed;
+    };
+
+    MX_IMPLEMENT_RTTI(PrefabTestWalker, Behaviour);
+
+    MX_TEST(Prefab_InstancesKeepMaterialsAndBehaviours) {
+        Test::UseGraphics();
+        Prefab::RegisterType<PrefabTestWalker>([](const PrefabTestWalker& _walker) -> Prefab::ComponentFactory {
+            return [speed = _walker.speed](GameObject& _object) { _object.addComponent<PrefabTestWalker>(speed); };
+        });
+
+        auto material = std::make_shared<Material>(Graphics::Get()->findShader("Standard"));
+        auto enemy = GameObject::Instantiate("Enemy");
+        enemy->addComponent<Renderer>()->setMaterial(material);
+        enemy->addComponent<PrefabTestWalker>(2.5f);
+
+        auto prefab = Prefab::Capture(enemy);
+        auto instances = prefab->instantiate(3);
+        MX_CHECK(instances.size() == 3);
+        for (auto& instance : instances) {
+            auto renderer = instance->getComponent<Renderer>();
+            MX_CHECK(renderer && renderer->getMaterials().size() == 1);
+            MX_CHECK(renderer->getMaterials().front() == material);
+
+            auto walker = instance->getComponent<PrefabTestWalker>();
+            MX_CHECK(walker && walker->speed == 2.5f);
+            instance->destroy(true);
+        }
+        enemy->destroy(true);
+    }
+
+    MX_TEST(Prefab_InstancesDontTakeTheMainCamera) {
+        Test::UseGraphics();
+        auto scene = SceneManager::Get()->getActiveScene();
+        const auto previous = scene->getMainCamera();
+
+        auto viewer = GameObject::Instantiate("Viewer");
+        auto camera = viewer->addComponent<Camera>(Vector2i(640, 480));
+        scene->setMainCamera(camera);
+
+        auto instances = Prefab::Capture(viewer)->instantiate(2);
+        MX_CHECK(instances.size() == 2);
+        MX_CHECK(scene->getMainCamera() == camera);
+        for (auto& instance : instances) {
+            MX_CHECK(instance->getComponent<Camera>());
+            instance->destroy(true);
+        }
+
+        if (previous)
+            scene->setMainCamera(previous);
+        viewer->destroy(true);
+    }
+}
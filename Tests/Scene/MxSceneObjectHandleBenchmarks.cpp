@@ -0,0 +1,105 @@
+#include "../MxTest.h"
+#include "../../Mx/Scene/MxSceneObjectHandle.h"
+#include "../../Mx/Scene/MxSceneObjectManager.h"
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+namespace Mix {
+    namespace {
+        class BenchObject final : public SceneObject {
+        public:
+            void destroyInternal(SceneObjectHandleBase& _handle, bool _immediate) override {}
+
+            uint32_t value = 1;
+        };
+
+        /** \brief The handle layout replaced by the slot map: a shared_ptr to a shared_ptr to the object. */
+        namespace Legacy {
+            struct InstanceData {
+                std::shared_ptr<SceneObject> object;
+                uint64_t instanceId = 0;
+            };
+
+            struct HandleData {
+                std::shared_ptr<InstanceData> mPtr;
+            };
+
+            template<typename _Ty>
+            class Handle {
+            public:
+                Handle() :mData(std::make_shared<HandleData>()) {}
+
+                explicit Handle(std::shared_ptr<HandleData> _data) :mData(std::move(_data)) {}
+
+                bool isDestroyed() const {
+                    return mData->mPtr == nullptr || mData->mPtr->object == nullptr || mData->mPtr->object->_isDestroyed();
+                }
+
+                _Ty* operator->() const {
+                    if (isDestroyed())
+                        throw std::runtime_error("SceneObject has been destroyed");
+                    return static_cast<_Ty*>(mData->mPtr->object.get());
+                }
+
+            private:
+                std::shared_ptr<HandleData> mData;
+            };
+        }
+
+        constexpr uint32_t HandleCount = 4096;
+    }
+
+    MX_BENCHMARK(SceneObjectHandle_CopyAndDeref) {
+        // Handles read the slots of a single published manager, so use the engine's rather than one of our own
+        Test::UseGraphics();
+        auto manager = SceneObjectManager::Get();
+        manager->reserve(HandleCount);
+
+        std::vector<SceneObjectHandleBase> registered;
+        std::vector<SceneObjectHandle<BenchObject>> handles;
+        std::vector<Legacy::Handle<BenchObject>> legacyHandles;
+        for (uint32_t i = 0; i < HandleCount; ++i) {
+            auto object = std::make_shared<BenchObject>();
+            registered.push_back(manager->registerObject(object));
+            handles.push_back(static_scene_object_cast<BenchObject>(registered.back()));
+
+            auto instanceData = std::make_shared<Legacy::InstanceData>();
+            instanceData->object = object;
+            instanceData->instanceId = i + 1;
+            legacyHandles.emplace_back(std::make_shared<Legacy::HandleData>(Legacy::HandleData{ instanceData }));
+        }
+
+        std::vector<SceneObjectHandle<BenchObject>> copies(HandleCount);
+        std::vector<Legacy::Handle<BenchObject>> legacyCopies(HandleCount);
+
+        // Each measure is one pass over all handles, the sums keep the loads from being optimized away
+        uint32_t sum = 0;
+        Test::Measure("slot map: copy 4096 handles", 2000, [&] {
+            std::copy(handles.begin(), handles.end(), copies.begin());
+        });
+        Test::Measure("legacy: copy 4096 handles", 2000, [&] {
+            std::copy(legacyHandles.begin(), legacyHandles.end(), legacyCopies.begin());
+        });
+        Test::Measure("slot map: deref 4096 handles", 2000, [&] {
+            for (auto& handle : handles)
+                sum += handle->value;
+        });
+        Test::Measure("legacy: deref 4096 handles", 2000, [&] {
+            for (auto& handle : legacyHandles)
+                sum += handle->value;
+        });
+        Test::Measure("slot map: default construct 4096 handles", 2000, [&] {
+            for (auto& handle : copies)
+                handle = SceneObjectHandle<BenchObject>();
+        });
+        Test::Measure("legacy: default construct 4096 handles", 2000, [&] {
+            for (auto& handle : legacyCopies)
+                handle = Legacy::Handle<BenchObject>();
+        });
+
+        manager->unregisterObjects(registered);
+        MX_CHECK(sum != 0);
+        MX_CHECK(handles.front().isDestroyed());
+    }
+}
@@ -0,0 +1,38 @@
+#include "../MxTest.h"
+#include "../../Mx/Utils/MxEvent.h"
+#include "../../Mx/Utils/MxLocalEvent.h"
+#include <string>
+
+namespace Mix {
+    MX_BENCHMARK(Event_Trigger) {
+        for (uint32_t listenerCount : { 1u, 10u, 100u }) {
+            // Each callback adds to its own counter so that no call can be merged with another
+            std::vector<uint32_t> counters(listenerCount, 0);
+
+            Event<void(uint32_t)> event;
+            LocalEvent<void(uint32_t)> localEvent;
+            std::vector<EventHandle> handles;
+            for (auto& counter : counters) {
+                handles.push_back(event.connect([&counter](uint32_t _value) { counter += _value; }));
+                localEvent.connect([&counter](uint32_t _value) { counter += _value; });
+            }
+
+            const std::string suffix = " with " + std::to_string(listenerCount) + (listenerCount == 1 ? " listener" : " listeners");
+            Test::Measure(("Event::trigger" + suffix).c_str(), 100000, [&] { event.trigger(1); });
+            Test::Measure(("LocalEvent::trigger" + suffix).c_str(), 100000, [&] { localEvent.trigger(1); });
+            MX_CHECK(counters.front() != 0);
+        }
+    }
+
+    MX_BENCHMARK(Event_QueuedPostAndDispatch) {
+        uint32_t counter = 0;
+        QueuedEvent<void(uint32_t)> event;
+        event.connect([&counter](uint32_t _value) { counter += _value; });
+
+        Test::Measure("QueuedEvent::post + dispatch, 1 listener", 100000, [&] {
+            event.post(1u);
+            event.dispatch();
+        });
+        MX_CHECK(counter != 0);
+    }
+}